@@ -0,0 +1,62 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <MLLib/CrossValidationReport.h>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Regressors
+{
+	/*
+	* A thread-safe store of cross-validation results, keyed on everything that determines them: the training data, the
+	* fold plan, the error metric, the regressor type and its parameters, and the modifier parameters. Trainers that are
+	* given a cache look each parameter set up before cross-validating it and record the result afterwards, so points that
+	* an optimiser revisits, or that differ only in settings which cannot change the model, are evaluated once.
+	*
+	* Each result is stored with the report of the cross-validation that produced it, so a parameter set found in the
+	* cache reports the same metrics and fold timings as when it was first scored.
+	*
+	* When constructed with a file path, existing results are loaded from that file and every new result is appended to
+	* it, allowing repeated runs on the same dataset to skip evaluations that have already been done. A file written in
+	* an older format is discarded and rewritten.
+	*/
+	template <typename T>
+	class CrossValidationCache
+	{
+	public:
+		CrossValidationCache();
+
+		explicit CrossValidationCache(std::string const& backingFilePath);
+
+		CrossValidationCache(CrossValidationCache const&) = delete;
+		CrossValidationCache& operator=(CrossValidationCache const&) = delete;
+
+		// report, if given, receives the report stored with the result
+		bool Find(std::string const& key, T& result, CrossValidationReport<T>* report = nullptr) const;
+
+		void Insert(std::string const& key, T const& result, CrossValidationReport<T> const& report = CrossValidationReport<T>());
+
+		size_t GetNumEntries() const;
+
+		// the number of calls to Find that returned a stored result
+		size_t GetNumHits() const;
+
+	private:
+		struct Entry
+		{
+			T Result;
+			CrossValidationReport<T> Report;
+		};
+
+		// written at the start of every backing file, identifying the layout of the records that follow
+		static constexpr char const* FileFormat = "CrossValidationCache/2";
+
+		mutable std::mutex Mutex;
+		std::unordered_map<std::string, Entry> Entries;
+		mutable size_t NumHits;
+		std::ofstream BackingFile;
+	};
+}
+
+#include "impl/CrossValidationCache.hpp"
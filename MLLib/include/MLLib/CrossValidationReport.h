@@ -0,0 +1,84 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <dlib/serialize.h>
+#include <dlib/statistics.h>
+#include <vector>
+
+namespace Regressors
+{
+	enum class ECrossValidationMetric
+	{
+		SumAbsoluteMax,
+		SumAbsoluteMean,
+		SumSquareMax,
+		SumSquareMean,
+		CovarianceCorrelation
+	};
+
+	/*
+	* The value of every ECrossValidationMetric over one set of predictions. The correlation of fewer than two
+	* predictions is undefined and is reported as NaN.
+	*/
+	template <typename T>
+	struct CrossValidationMetrics
+	{
+		T SumAbsoluteMax;
+		T SumAbsoluteMean;
+		T SumSquareMax;
+		T SumSquareMean;
+		T CovarianceCorrelation;
+
+		CrossValidationMetrics();
+
+		CrossValidationMetrics(dlib::running_stats<T> const& rs_abs,
+			dlib::running_stats<T> const& rs_sq,
+			dlib::running_scalar_covariance<T> const& rs_rc);
+
+		friend void serialize(CrossValidationMetrics const& item, std::ostream& out)
+		{
+			dlib::serialize(item.SumAbsoluteMax, out);
+			dlib::serialize(item.SumAbsoluteMean, out);
+			dlib::serialize(item.SumSquareMax, out);
+			dlib::serialize(item.SumSquareMean, out);
+			dlib::serialize(item.CovarianceCorrelation, out);
+		}
+
+		friend void deserialize(CrossValidationMetrics& item, std::istream& in)
+		{
+			dlib::deserialize(item.SumAbsoluteMax, in);
+			dlib::deserialize(item.SumAbsoluteMean, in);
+			dlib::deserialize(item.SumSquareMax, in);
+			dlib::deserialize(item.SumSquareMean, in);
+			dlib::deserialize(item.CovarianceCorrelation, in);
+		}
+	};
+
+	/*
+	* Everything measured while cross-validating one parameter set: every metric over all of the tested examples, the
+	* same metrics for each fold on its own, and the wall time taken to train and test each fold. Strategies that score
+	* a single fit report it as one fold.
+	*/
+	template <typename T>
+	struct CrossValidationReport
+	{
+		CrossValidationMetrics<T> Metrics;
+		std::vector<CrossValidationMetrics<T>> FoldMetrics;
+		std::vector<double> FoldSeconds;
+
+		friend void serialize(CrossValidationReport const& item, std::ostream& out)
+		{
+			serialize(item.Metrics, out);
+			dlib::serialize(item.FoldMetrics, out);
+			dlib::serialize(item.FoldSeconds, out);
+		}
+
+		friend void deserialize(CrossValidationReport& item, std::istream& in)
+		{
+			deserialize(item.Metrics, in);
+			dlib::deserialize(item.FoldMetrics, in);
+			dlib::deserialize(item.FoldSeconds, in);
+		}
+	};
+}
+
+#include "impl/CrossValidationReport.hpp"
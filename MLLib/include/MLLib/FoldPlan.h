@@ -0,0 +1,53 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <MLLib/RandomStream.h>
+#include <dlib/rand.h>
+#include <vector>
+
+namespace Regressors
+{
+	/*
+	* The partition of a training set into cross-validation folds. The examples are shuffled once, from the
+	* random seed, when the plan is constructed; every evaluation that is handed the same plan then sees exactly
+	* the same train/test splits, so regressors and parameter sets can be compared like for like.
+	*
+	* Fold f tests on shuffled positions [f * chunk, (f + 1) * chunk) where chunk = numExamples / numFolds and
+	* trains on the remaining positions in shuffled order. Any remainder examples are always trained on. A plan can
+	* also be built from an ordering that has already been shuffled, such as a prefix of another plan's ordering.
+	*
+	* The plan also carries the root random stream of the training runs it is used for, keyed on the seed (or on the
+	* ordering it was built from). Any randomised step of a run draws from a substream of it, keyed on the step's own
+	* evaluation or fold index, so runs are reproducible whatever the number of threads.
+	*/
+	class FoldPlan
+	{
+	public:
+		FoldPlan(std::string const& randomSeed,
+			size_t const numExamples,
+			size_t const numFolds);
+
+		FoldPlan(std::vector<size_t> const& shuffledIndices,
+			size_t const numFolds);
+
+		size_t GetNumExamples() const;
+		size_t GetNumFolds() const;
+
+		std::vector<size_t> const& GetShuffledIndices() const;
+		std::vector<size_t> const& GetTrainIndices(size_t const fold) const;
+		std::vector<size_t> const& GetTestIndices(size_t const fold) const;
+
+		RandomStream const& GetRandomStream() const;
+
+	private:
+		void Partition(size_t const numFolds);
+
+		static std::string SerializeOrdering(std::vector<size_t> const& shuffledIndices);
+
+		std::vector<size_t> ShuffledIndices;
+		std::vector<std::vector<size_t>> TrainIndices;
+		std::vector<std::vector<size_t>> TestIndices;
+		RandomStream Stream;
+	};
+}
+
+#include "impl/FoldPlan.hpp"
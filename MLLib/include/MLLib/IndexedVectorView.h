@@ -0,0 +1,66 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <vector>
+
+namespace Regressors
+{
+	/*
+	* A read-only view over a subset of a std::vector, addressed through a vector of indices into it.
+	* Neither the source nor the indices are owned - both must outlive the view.
+	*
+	* Views are accepted anywhere dlib expects a sample or label vector (dlib calls mat() on its inputs,
+	* which resolves to the overload below), so cross-validation folds can be passed straight to the
+	* trainers without copying the underlying examples.
+	*/
+	template <typename ValueType>
+	class IndexedVectorView
+	{
+	public:
+		typedef ValueType value_type;
+
+		IndexedVectorView(std::vector<ValueType> const& source,
+			std::vector<size_t> const& indices);
+
+		size_t size() const;
+
+		ValueType const& operator[](size_t const index) const;
+
+		std::vector<ValueType> Materialise() const;
+
+	private:
+		std::vector<ValueType> const* Source;
+		std::vector<size_t> const* Indices;
+	};
+
+	template <typename ValueType>
+	struct op_indexed_vector_to_mat : dlib::does_not_alias
+	{
+		op_indexed_vector_to_mat(IndexedVectorView<ValueType> const& view_) : view(view_) {}
+
+		IndexedVectorView<ValueType> const view;
+
+		const static long cost = 1;
+		const static long NR = 0;
+		const static long NC = 1;
+		typedef ValueType type;
+		typedef ValueType const& const_ret_type;
+		typedef dlib::default_memory_manager mem_manager_type;
+		typedef dlib::row_major_layout layout_type;
+
+		const_ret_type apply(long r, long) const { return view[r]; }
+
+		long nr() const { return view.size(); }
+		long nc() const { return 1; }
+	};
+
+	template <typename ValueType>
+	dlib::matrix_op<op_indexed_vector_to_mat<ValueType>> const mat(IndexedVectorView<ValueType> const& view);
+
+	template <typename ValueType>
+	std::vector<ValueType> const& AsStdVector(std::vector<ValueType> const& examples);
+
+	template <typename ValueType>
+	std::vector<ValueType> AsStdVector(IndexedVectorView<ValueType> const& examples);
+}
+
+#include "impl/IndexedVectorView.hpp"
@@ -0,0 +1,62 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <dlib/svm.h>
+
+namespace Regressors
+{
+	/*
+	* A kernel decision function, f(x) = sum_i alpha_i k(x, b_i) - bias, repacked for prediction. dlib keeps each basis
+	* vector in its own allocation; here they are the rows of one contiguous matrix, so a batch of inputs is scored by
+	* one blocked pass of the inputs over the basis vectors, the kernel's elementwise transform of the resulting dot
+	* products, or of the squared distances for distance kernels such as the radial basis kernel, and a matrix-vector
+	* product with alpha.
+	*
+	* Single and batched evaluation sum in the same order, and transform kernel values elementwise, and so agree exactly.
+	* Both differ from the dlib decision function only by rounding, as exponentials and hyperbolic tangents may be
+	* vectorised.
+	*/
+	template <class KernelType>
+	class KernelExpansion
+	{
+	public:
+		typedef typename KernelType::SampleType SampleType;
+		typedef typename KernelType::SampleType::type T;
+		typedef dlib::decision_function<typename KernelType::KernelFunctionType> DecisionFunction;
+
+		// samples whose dot products with a basis vector are computed while that basis vector is in cache
+		static long const BlockSize;
+		// basis vectors whose kernel values a single input's evaluation transforms together, held on the stack
+		static constexpr long TransformBlockSize = 64;
+
+		KernelExpansion();
+
+		explicit KernelExpansion(DecisionFunction const& function);
+
+		T operator()(SampleType const& input) const;
+
+		// scores the first numInputs rows of inputs, one input per row, into outputs; kernelValues is scratch that keeps
+		// its storage between calls with the same number of rows
+		void Evaluate(dlib::matrix<T> const& inputs, long const numInputs, T* outputs, dlib::matrix<T>& kernelValues) const;
+
+		long GetNumBasisVectors() const;
+
+	private:
+		// one ordinate's contribution to the dot product, or to the squared distance for distance kernels
+		static T PairTerm(T const basisOrdinate, T const inputOrdinate);
+
+		// replaces the summed pair terms of an input with numValues basis vectors by the kernel values
+		void TransformPairValues(T* values, long const numValues) const;
+
+		typename KernelType::KernelFunctionType Kernel;
+		dlib::matrix<T> BasisVectors;
+		col_vector<T> Alpha;
+		T Bias;
+	};
+
+	// the expansion of regression types whose decision functions are not kernel expansions, which is never built
+	struct NoKernelExpansion
+	{
+	};
+}
+
+#include "impl/KernelExpansion.hpp"
@@ -1,10 +1,18 @@
 #pragma once
 #include <MLLib/TypeDefinitions.h>
+#include <MLLib/ParameterMapping.h>
+#include <MLLib/VectorMath.h>
 #include <dlib/svm.h>
 #include <dlib/random_forest.h>
 
 namespace Regressors
 {
+	DECLARE_ENUM(EKernelTypes,
+		linear,
+		polynomial,
+		radialBasis,
+		sigmoid);
+
 	namespace KernelTypes
 	{
 		template <typename SampleType>
@@ -18,6 +26,7 @@ namespace Regressors
 			LinearKernel() = delete;
 
 			static size_t const NumKernelParams;
+			static EKernelTypes const KernelTypeEnum;
 
 			struct OneShotTrainingParams
 			{
@@ -44,6 +53,17 @@ namespace Regressors
 
 			static KernelFunctionType GetKernel(OneShotTrainingParams const& osParams);
 
+			// whether the kernel is evaluated from squared distances rather than dot products by a KernelExpansion
+			static constexpr bool IsDistanceKernel = false;
+
+			// replaces the dot products of an input with numValues basis vectors by the kernel values, so that the kernel
+			// against every basis vector can come from one matrix product
+			static void FromDotProducts(KernelFunctionType const& kernel, T* values, size_t const numValues);
+
+			// appends the number of values to try of each parameter, in the order IterateKernelParams nests them
+			static void AppendKernelParamsAxes(CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <class RegressionType>
 			static void IterateKernelParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 				CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -55,18 +75,18 @@ namespace Regressors
 				col_vector<T>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 				size_t const mapOffset);
 
 			template <size_t TotalNumParams>
 			static void UnpackParameters(OneShotTrainingParams& osTrainingParams,
 				col_vector<T> const& vecParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -84,6 +104,7 @@ namespace Regressors
 			PolynomialKernel() = delete;
 
 			static size_t const NumKernelParams;
+			static EKernelTypes const KernelTypeEnum;
 
 			struct OneShotTrainingParams
 			{
@@ -123,6 +144,7 @@ namespace Regressors
 				T LowerCoeff;
 				T LowerDegree;
 				T UpperGamma;
+				EParameterScale GammaScale;
 				T UpperCoeff;
 				T UpperDegree;
 
@@ -131,6 +153,17 @@ namespace Regressors
 
 			static KernelFunctionType GetKernel(OneShotTrainingParams const& osParams);
 
+			// whether the kernel is evaluated from squared distances rather than dot products by a KernelExpansion
+			static constexpr bool IsDistanceKernel = false;
+
+			// replaces the dot products of an input with numValues basis vectors by the kernel values, so that the kernel
+			// against every basis vector can come from one matrix product
+			static void FromDotProducts(KernelFunctionType const& kernel, T* values, size_t const numValues);
+
+			// appends the number of values to try of each parameter, in the order IterateKernelParams nests them
+			static void AppendKernelParamsAxes(CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <class RegressionType>
 			static void IterateKernelParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 				CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -142,18 +175,18 @@ namespace Regressors
 				col_vector<T>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 				size_t const mapOffset);
 
 			template <size_t TotalNumParams>
 			static void UnpackParameters(OneShotTrainingParams& osTrainingParams,
 				col_vector<T> const& vecParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -171,6 +204,7 @@ namespace Regressors
 			RadialBasisKernel() = delete;
 
 			static size_t const NumKernelParams;
+			static EKernelTypes const KernelTypeEnum;
 
 			struct OneShotTrainingParams
 			{
@@ -200,12 +234,24 @@ namespace Regressors
 			{
 				T LowerGamma;
 				T UpperGamma;
+				EParameterScale GammaScale;
 
 				FindMinGlobalTrainingParams();
 			};
 
 			static KernelFunctionType GetKernel(OneShotTrainingParams const& osParams);
 
+			// whether the kernel is evaluated from squared distances rather than dot products by a KernelExpansion
+			static constexpr bool IsDistanceKernel = true;
+
+			// replaces the squared distances of an input from numValues basis vectors by the kernel values; the distances are
+			// summed directly rather than rebuilt from dot products and norms, which cancel for nearby samples
+			static void FromSquaredDistances(KernelFunctionType const& kernel, T* values, size_t const numValues);
+
+			// appends the number of values to try of each parameter, in the order IterateKernelParams nests them
+			static void AppendKernelParamsAxes(CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <class RegressionType>
 			static void IterateKernelParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 				CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -217,18 +263,18 @@ namespace Regressors
 				col_vector<T>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 				size_t const mapOffset);
 
 			template <size_t TotalNumParams>
 			static void UnpackParameters(OneShotTrainingParams& osTrainingParams,
 				col_vector<T> const& vecParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -246,6 +292,7 @@ namespace Regressors
 			SigmoidKernel() = delete;
 
 			static size_t const NumKernelParams;
+			static EKernelTypes const KernelTypeEnum;
 
 			struct OneShotTrainingParams
 			{
@@ -280,6 +327,7 @@ namespace Regressors
 				T LowerGamma;
 				T LowerCoeff;
 				T UpperGamma;
+				EParameterScale GammaScale;
 				T UpperCoeff;
 
 				FindMinGlobalTrainingParams();
@@ -287,6 +335,17 @@ namespace Regressors
 
 			static KernelFunctionType GetKernel(OneShotTrainingParams const& osParams);
 
+			// whether the kernel is evaluated from squared distances rather than dot products by a KernelExpansion
+			static constexpr bool IsDistanceKernel = false;
+
+			// replaces the dot products of an input with numValues basis vectors by the kernel values, so that the kernel
+			// against every basis vector can come from one matrix product
+			static void FromDotProducts(KernelFunctionType const& kernel, T* values, size_t const numValues);
+
+			// appends the number of values to try of each parameter, in the order IterateKernelParams nests them
+			static void AppendKernelParamsAxes(CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <class RegressionType>
 			static void IterateKernelParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 				CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -298,18 +357,18 @@ namespace Regressors
 				col_vector<T>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 				size_t const mapOffset);
 
 			template <size_t TotalNumParams>
 			static void UnpackParameters(OneShotTrainingParams& osTrainingParams,
 				col_vector<T> const& vecParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -353,6 +412,10 @@ namespace Regressors
 
 			static ExtractorFunctionType GetExtractor(OneShotTrainingParams const& osParams);
 
+			// appends the number of values to try of each parameter, in the order IterateExtractorParams nests them
+			static void AppendExtractorParamsAxes(CrossValidationTrainingParams const& extractorCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <class RegressionType>
 			static void IterateExtractorParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 				CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -364,18 +427,18 @@ namespace Regressors
 				col_vector<T>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 				size_t const mapOffset);
 
 			template <size_t TotalNumParams>
 			static void UnpackParameters(OneShotTrainingParams& osTrainingParams,
 				col_vector<T> const& vecParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -389,6 +452,14 @@ namespace Regressors
 		template <typename SampleType>
 		size_t const SigmoidKernel<SampleType>::NumKernelParams = 2ull;
 		template <typename SampleType>
+		EKernelTypes const LinearKernel<SampleType>::KernelTypeEnum = EKernelTypes::linear;
+		template <typename SampleType>
+		EKernelTypes const PolynomialKernel<SampleType>::KernelTypeEnum = EKernelTypes::polynomial;
+		template <typename SampleType>
+		EKernelTypes const RadialBasisKernel<SampleType>::KernelTypeEnum = EKernelTypes::radialBasis;
+		template <typename SampleType>
+		EKernelTypes const SigmoidKernel<SampleType>::KernelTypeEnum = EKernelTypes::sigmoid;
+		template <typename SampleType>
 		size_t const DenseExtractor<SampleType>::NumExtractorParams = 0ull;
 	}
 }
@@ -1,8 +1,14 @@
 #pragma once
 #include <MLLib/TypeDefinitions.h>
+#include <MLLib/ParameterMapping.h>
 
 namespace Regressors
 {
+	DECLARE_ENUM(ELinkFunctionTypes,
+		logit,
+		fourier,
+		lagrange);
+
 	namespace LinkFunctionTypes
 	{
 		template <class KernelType>
@@ -17,6 +23,7 @@ namespace Regressors
 			LogitLinkFunction() = delete;
 
 			static size_t const NumLinkFunctionParams;
+			static ELinkFunctionTypes const LinkFunctionTypeEnum;
 
 			struct OneShotTrainingParams
 			{
@@ -64,6 +71,11 @@ namespace Regressors
 				col_vector<ScalarType> const& inputExamples,
 				col_vector<ScalarType> const& targetExamples);
 
+			// appends the number of values to try of each parameter, in the order IterateLinkFunctionParams nests them
+			static void AppendLinkFunctionParamsAxes(CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
+				typename KernelType::CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <class RegressionType>
 			static void IterateLinkFunctionParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 				CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
@@ -76,18 +88,18 @@ namespace Regressors
 				col_vector<ScalarType>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams>& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams>& optimiseParamsMap,
 				size_t const mapOffset);
 
 			template <size_t TotalNumParams>
 			static void UnpackParameters(OneShotTrainingParams& osTrainingParams,
 				col_vector<ScalarType> const& vecParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -104,6 +116,7 @@ namespace Regressors
 			FourierLinkFunction() = delete;
 
 			static size_t const NumLinkFunctionParams;
+			static ELinkFunctionTypes const LinkFunctionTypeEnum;
 
 			struct OneShotTrainingParams
 			{
@@ -177,6 +190,11 @@ namespace Regressors
 				col_vector<ScalarType> const& inputExamples,
 				col_vector<ScalarType> const& targetExamples);
 
+			// appends the number of values to try of each parameter, in the order IterateLinkFunctionParams nests them
+			static void AppendLinkFunctionParamsAxes(CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
+				typename KernelType::CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <class RegressionType>
 			static void IterateLinkFunctionParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 				CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
@@ -189,18 +207,18 @@ namespace Regressors
 				col_vector<ScalarType>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams>& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams>& optimiseParamsMap,
 				size_t const mapOffset);
 
 			template <size_t TotalNumParams>
 			static void UnpackParameters(OneShotTrainingParams& osTrainingParams,
 				col_vector<ScalarType> const& vecParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -217,6 +235,7 @@ namespace Regressors
 			LagrangeLinkFunction() = delete;
 
 			static size_t const NumLinkFunctionParams;
+			static ELinkFunctionTypes const LinkFunctionTypeEnum;
 
 			struct OneShotTrainingParams
 			{
@@ -272,6 +291,11 @@ namespace Regressors
 				col_vector<ScalarType> const& inputExamples,
 				col_vector<ScalarType> const& targetExamples);
 
+			// appends the number of values to try of each parameter, in the order IterateLinkFunctionParams nests them
+			static void AppendLinkFunctionParamsAxes(CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
+				typename KernelType::CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <class RegressionType>
 			static void IterateLinkFunctionParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 				CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
@@ -284,18 +308,18 @@ namespace Regressors
 				col_vector<ScalarType>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams>& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams>& optimiseParamsMap,
 				size_t const mapOffset);
 
 			template <size_t TotalNumParams>
 			static void UnpackParameters(OneShotTrainingParams& osTrainingParams,
 				col_vector<ScalarType> const& vecParams,
-				std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -308,6 +332,15 @@ namespace Regressors
 
 		template <class KernelType>
 		size_t const LagrangeLinkFunction<KernelType>::NumLinkFunctionParams = 0ull;
+
+		template <class KernelType>
+		ELinkFunctionTypes const LogitLinkFunction<KernelType>::LinkFunctionTypeEnum = ELinkFunctionTypes::logit;
+
+		template <class KernelType>
+		ELinkFunctionTypes const FourierLinkFunction<KernelType>::LinkFunctionTypeEnum = ELinkFunctionTypes::fourier;
+
+		template <class KernelType>
+		ELinkFunctionTypes const LagrangeLinkFunction<KernelType>::LinkFunctionTypeEnum = ELinkFunctionTypes::lagrange;
 	}
 }
 
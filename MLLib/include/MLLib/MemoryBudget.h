@@ -0,0 +1,59 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <condition_variable>
+#include <mutex>
+
+namespace Regressors
+{
+	/*
+	* A thread-safe limit on the memory that concurrently running training tasks may use. Each fold or single-fit task
+	* estimates its peak memory from its regression parameters and the size of its training data, and is only admitted
+	* once the estimates of the tasks already running leave room for it; until then it waits, holding its thread. A task
+	* whose estimate alone exceeds the budget is admitted once no other task is running, so every task eventually runs.
+	*
+	* One budget may be shared between any number of training runs, including runs on different thread pools, to bound
+	* their combined memory rather than the memory of each.
+	*/
+	class MemoryBudget
+	{
+	public:
+		explicit MemoryBudget(size_t const numBytes);
+
+		MemoryBudget(MemoryBudget const&) = delete;
+		MemoryBudget& operator=(MemoryBudget const&) = delete;
+
+		void Acquire(size_t const numBytes);
+		void Release(size_t const numBytes);
+
+		size_t GetNumBytes() const;
+		size_t GetNumBytesInUse() const;
+		size_t GetPeakNumBytesInUse() const;
+
+	private:
+		mutable std::mutex Mutex;
+		std::condition_variable Released;
+		size_t const NumBytes;
+		size_t NumBytesInUse;
+		size_t PeakNumBytesInUse;
+	};
+
+	/*
+	* Holds an admission to a budget for the lifetime of a task; a null budget admits immediately.
+	*/
+	class MemoryAdmission
+	{
+	public:
+		MemoryAdmission(MemoryBudget* const budget,
+			size_t const numBytes);
+		~MemoryAdmission();
+
+		MemoryAdmission(MemoryAdmission const&) = delete;
+		MemoryAdmission& operator=(MemoryAdmission const&) = delete;
+
+	private:
+		MemoryBudget* const Budget;
+		size_t const NumBytes;
+	};
+}
+
+#include "impl/MemoryBudget.hpp"
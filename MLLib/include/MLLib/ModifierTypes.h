@@ -1,5 +1,6 @@
 #pragma once
 #include <MLLib/TypeDefinitions.h>
+#include <MLLib/ParameterMapping.h>
 #include <MLLib/PrincipalComponentAnalysis.h>
 #include <dlib/statistics.h>
 
@@ -61,6 +62,14 @@ namespace Regressors
 				dlib::vector_normalizer<SampleType> Normaliser;
 
 				void operator()(SampleType& input) const;
+				// writes the modified input to output, which allocates only when output is not already the modified size
+				void operator()(SampleType const& input, SampleType& output) const;
+				// the modifier as output = matrix * input + offset, for inputs of numInputs ordinates
+				void GetAffineTransform(long const numInputs, dlib::matrix<T>& matrix, col_vector<T>& offset) const;
+				// ordinates of the inputs the modifier was trained on, or 0 when the modifier accepts any input size
+				long GetNumInputs() const;
+				// whether the affine transform mixes ordinates; only chains with such a modifier are fused into one dense map
+				static constexpr bool HasDenseTransform = false;
 
 				friend void serialize(ModifierFunction const& item, std::ostream& out)
 				{
@@ -77,19 +86,23 @@ namespace Regressors
 
 			static void TrainModifier(ModifierFunction& function, OneShotTrainingParams const& params, std::vector<SampleType> const& inputExamples, std::vector<T> const& targetExamples);
 
+			// appends the number of values to try of each parameter, in the order IterateModifierParams nests them
+			static void AppendModifierParamsAxes(CrossValidationTrainingParams const& modifierCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <size_t I, class... ModifierCrossValidationTrainingTypes>
 			static void IterateModifierParams(std::tuple<ModifierCrossValidationTrainingTypes...> const& modifierCrossValidationParams,
 				std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>& modifierOneShotTrainingParamsToTry,
 				std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>& modifierTrainingParams);
 
 			template <size_t TotalNumParams>
-			static void ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& params);
+			static void ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& params);
 
 			template <size_t TotalNumParams>
 			static void PackageParameters(col_vector<T>& lowerParams,
 				col_vector<T>& upperParams,
 				std::vector<bool>& isIntegerParam,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset,
 				FindMinGlobalTrainingParams const& fmgTrainingParams);
@@ -97,7 +110,7 @@ namespace Regressors
 			template <size_t I, size_t TotalNumParams, class... ModifierOneShotTrainingParams>
 			static void UnpackParameters(std::tuple<ModifierOneShotTrainingParams...>& modifierOneShotTrainingParams,
 				col_vector<T> const& vecParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -143,6 +156,7 @@ namespace Regressors
 				typedef InputPCAModifier ModifierType;
 				T LowerTargetVariance;
 				T UpperTargetVariance;
+				EParameterScale TargetVarianceScale;
 
 				FindMinGlobalTrainingParams();
 			};
@@ -156,6 +170,14 @@ namespace Regressors
 				PCA::PrincipalComponentAnalysis<SampleType> PCAModel;
 
 				void operator()(SampleType& input) const;
+				// writes the modified input to output, which allocates only when output is not already the modified size
+				void operator()(SampleType const& input, SampleType& output) const;
+				// the modifier as output = matrix * input + offset, for inputs of numInputs ordinates
+				void GetAffineTransform(long const numInputs, dlib::matrix<T>& matrix, col_vector<T>& offset) const;
+				// ordinates of the inputs the modifier was trained on, or 0 when the modifier accepts any input size
+				long GetNumInputs() const;
+				// whether the affine transform mixes ordinates; only chains with such a modifier are fused into one dense map
+				static constexpr bool HasDenseTransform = true;
 
 				friend void serialize(ModifierFunction const& item, std::ostream& out)
 				{
@@ -172,19 +194,23 @@ namespace Regressors
 
 			static void TrainModifier(ModifierFunction& function, OneShotTrainingParams const& params, std::vector<SampleType> const& inputExamples, std::vector<T> const& targetExamples);
 
+			// appends the number of values to try of each parameter, in the order IterateModifierParams nests them
+			static void AppendModifierParamsAxes(CrossValidationTrainingParams const& modifierCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <size_t I, class... ModifierCrossValidationTrainingTypes>
 			static void IterateModifierParams(std::tuple<ModifierCrossValidationTrainingTypes...> const& modifierCrossValidationParams,
 				std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>& modifierOneShotTrainingParamsToTry,
 				std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>& modifierTrainingParams);
 
 			template <size_t TotalNumParams>
-			static void ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& params);
+			static void ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& params);
 
 			template <size_t TotalNumParams>
 			static void PackageParameters(col_vector<T>& lowerParams,
 				col_vector<T>& upperParams,
 				std::vector<bool>& isIntegerParam,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset,
 				FindMinGlobalTrainingParams const& fmgTrainingParams);
@@ -192,7 +218,7 @@ namespace Regressors
 			template <size_t I, size_t TotalNumParams, class... ModifierOneShotTrainingParams>
 			static void UnpackParameters(std::tuple<ModifierOneShotTrainingParams...>& modifierOneShotTrainingParams,
 				col_vector<T> const& vecParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -238,6 +264,7 @@ namespace Regressors
 				typedef FeatureSelectionModifier ModifierType;
 				T LowerFeatureFraction;
 				T UpperFeatureFraction;
+				EParameterScale FeatureFractionScale;
 
 				FindMinGlobalTrainingParams();
 			};
@@ -251,6 +278,14 @@ namespace Regressors
 				std::vector<size_t> FeatureIndices;
 
 				void operator()(SampleType& input) const;
+				// writes the modified input to output, which allocates only when output is not already the modified size
+				void operator()(SampleType const& input, SampleType& output) const;
+				// the modifier as output = matrix * input + offset, for inputs of numInputs ordinates
+				void GetAffineTransform(long const numInputs, dlib::matrix<T>& matrix, col_vector<T>& offset) const;
+				// ordinates of the inputs the modifier was trained on, or 0 when the modifier accepts any input size
+				long GetNumInputs() const;
+				// whether the affine transform mixes ordinates; only chains with such a modifier are fused into one dense map
+				static constexpr bool HasDenseTransform = false;
 
 				friend void serialize(ModifierFunction const& item, std::ostream& out)
 				{
@@ -271,19 +306,23 @@ namespace Regressors
 				std::vector<T> const& targetExamples,
 				T const& featureFraction);
 
+			// appends the number of values to try of each parameter, in the order IterateModifierParams nests them
+			static void AppendModifierParamsAxes(CrossValidationTrainingParams const& modifierCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			template <size_t I, class... ModifierCrossValidationTrainingTypes>
 			static void IterateModifierParams(std::tuple<ModifierCrossValidationTrainingTypes...> const& modifierCrossValidationParams,
 				std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>& modifierOneShotTrainingParamsToTry,
 				std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>& modifierTrainingParams);
 
 			template <size_t TotalNumParams>
-			static void ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& fmgParams);
+			static void ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& fmgParams);
 
 			template <size_t TotalNumParams>
 			static void PackageParameters(col_vector<T>& lowerParams,
 				col_vector<T>& upperParams,
 				std::vector<bool>& isIntegerParam,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset,
 				FindMinGlobalTrainingParams const& fmgTrainingParams);
@@ -291,7 +330,7 @@ namespace Regressors
 			template <size_t I, size_t TotalNumParams, class... ModifierOneShotTrainingParams>
 			static void UnpackParameters(std::tuple<ModifierOneShotTrainingParams...>& modifierOneShotTrainingParams,
 				col_vector<T> const& vecParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t const mapOffset,
 				size_t& paramsOffset);
 		};
@@ -0,0 +1,35 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+
+namespace Regressors
+{
+	enum class EParameterScale
+	{
+		// searched uniformly between its bounds
+		Linear,
+		// searched uniformly in the logarithm of the parameter, for positive parameters spanning several decades
+		Log,
+		// searched uniformly in the log-odds of the parameter, for fractions strictly between zero and one
+		Logit
+	};
+
+	/*
+	* How one parameter of a find_min_global search is handed to the optimiser: whether it is optimised at all, the value
+	* it is held at when it is not, and the scale on which the optimiser searches it. The optimiser only ever sees
+	* ToSearchSpace of a parameter's bounds and proposes points that are mapped back with FromSearchSpace.
+	*/
+	template <typename T>
+	struct ParameterMapping
+	{
+		bool Optimise;
+		T FixedValue;
+		EParameterScale Scale;
+
+		ParameterMapping();
+
+		T ToSearchSpace(T const& value) const;
+		T FromSearchSpace(T const& searchValue) const;
+	};
+}
+
+#include "impl/ParameterMapping.hpp"
@@ -0,0 +1,32 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <vector>
+
+namespace Regressors
+{
+	/*
+	* Scratch space for prediction. Each modifier of a regressor's chain writes its output to its own buffer here, so
+	* once a first prediction has sized the buffers every later prediction through the same chain runs without heap
+	* allocation. A workspace may be reused across regressors, but alternating between chains whose modifiers output
+	* different sizes reallocates the buffers; callers doing so should keep one workspace per regressor.
+	*/
+	template <typename SampleType>
+	struct PredictionWorkspace
+	{
+		// output of each modifier, in chain order
+		std::vector<SampleType> ModifierOutputs;
+		// output of a modifier chain that has been fused into a single affine map
+		SampleType FusedOutput;
+		// a chunk of a batch's inputs and of their fused outputs, one sample per column
+		dlib::matrix<typename SampleType::type> BatchInputs;
+		dlib::matrix<typename SampleType::type> BatchOutputs;
+		// a chunk of a batch's modified inputs, one sample per row, and their kernel values against each basis vector
+		dlib::matrix<typename SampleType::type> BatchSamples;
+		dlib::matrix<typename SampleType::type> BatchKernelValues;
+
+		// the workspace of the calling thread, used by predictions that are not handed one
+		static PredictionWorkspace& ThreadLocal();
+	};
+}
+
+#include "impl/PredictionWorkspace.hpp"
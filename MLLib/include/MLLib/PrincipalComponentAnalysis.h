@@ -24,6 +24,12 @@ namespace PCA
 
 		SampleType Encode(SampleType const& data, size_t nModes) const;
 
+		// as above, writing the modes to params, which allocates only when params is not already nModes long
+		void Encode(SampleType const& data, size_t nModes, SampleType& params) const;
+
+		// Encode as params = matrix * data + offset
+		void GetAffineTransform(size_t nModes, dlib::matrix<T>& matrix, dlib::matrix<T, 0, 1>& offset) const;
+
 		SampleType Decode(SampleType const& params) const;
 
 		size_t nParams() const;
@@ -0,0 +1,50 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <dlib/uintn.h>
+#include <array>
+#include <string>
+
+namespace Regressors
+{
+	/*
+	* A counter-based (Philox4x32-10) random number stream. The n-th number of a stream depends only on the random seed,
+	* the stream's identity and n, never on which thread draws it or on what other streams have drawn, so work that is
+	* split across threads can give every task its own stream and still reproduce the same results for any number of
+	* threads.
+	*
+	* Streams form a tree: GetSubstream(id) derives an independent child stream from a parent and an id such as a task,
+	* evaluation or fold index. Deriving a substream does not advance the parent.
+	*/
+	class RandomStream
+	{
+	public:
+		explicit RandomStream(std::string const& randomSeed);
+
+		RandomStream GetSubstream(dlib::uint64 const id) const;
+
+		dlib::uint32 GetRandom32BitNumber();
+		dlib::uint64 GetRandom64BitNumber();
+		// uniform on [0, 1)
+		double GetRandomDouble();
+		// uniform on [0, n)
+		size_t GetRandomIndex(size_t const n);
+
+	private:
+		typedef std::array<dlib::uint32, 4> Block;
+		typedef std::array<dlib::uint32, 2> Key;
+
+		RandomStream(Key const& key,
+			dlib::uint64 const streamId);
+
+		static Block Philox(Block counter,
+			Key key);
+
+		Key StreamKey;
+		dlib::uint64 StreamId;
+		dlib::uint64 Counter;
+		Block Buffer;
+		size_t BufferPosition;
+	};
+}
+
+#include "impl/RandomStream.hpp"
@@ -1,7 +1,10 @@
 #pragma once
 #include <MLLib/TypeDefinitions.h>
+#include <MLLib/ParameterMapping.h>
+#include <MLLib/IndexedVectorView.h>
 #include <MLLib/KernelTypes.h>
 #include <MLLib/GKMTrainer.h>
+#include <MLLib/KernelExpansion.h>
 #include <dlib/svm.h>
 
 namespace Regressors
@@ -23,10 +26,13 @@ namespace Regressors
 			 typedef typename KernelType::SampleType SampleType;
 			 typedef typename KernelType::SampleType::type T;
 			 typedef dlib::decision_function<typename KernelType::KernelFunctionType> DecisionFunction;
+			 typedef KernelExpansion<KernelType> KernelExpansionType;
 
 			 KernelRidgeRegression() = delete;
 			 size_t static const NumTotalParams;
 			 size_t static const NumRegressionParams;
+			 bool static const ProvidesLeaveOneOutValues;
+			 bool static const ProvidesOutOfBagValues;
 
 			 struct OneShotTrainingParams : public RegressorTrainer::RegressionOneShotTrainingParamsBase
 			 {
@@ -38,7 +44,7 @@ namespace Regressors
 
 				 template <size_t TotalNumParams>
 				 OneShotTrainingParams(col_vector<T> const& vecParams,
-					 std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+					 std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 					 size_t& paramsOffset);
 
 				 ERegressorTypes GetRegressionType() const override;
@@ -73,19 +79,24 @@ namespace Regressors
 				 unsigned long UpperMaxBasisFunctions;
 				 T LowerLambda;
 				 T UpperLambda;
+				 EParameterScale LambdaScale;
 				 typename KernelType::FindMinGlobalTrainingParams KernelFindMinGlobalTrainingParams;
 
 				 FindMinGlobalTrainingParams();
 			 };
 
-			 template <class... ModifierFunctionTypes>
-			 static impl<KernelRidgeRegression, ModifierFunctionTypes...> Train(std::vector<SampleType> const& inputExamples,
-				 std::vector<T> const& targetExamples,
+			 template <class SampleContainerType, class TargetContainerType, class... ModifierFunctionTypes>
+			 static impl<KernelRidgeRegression, ModifierFunctionTypes...> Train(SampleContainerType const& inputExamples,
+				 TargetContainerType const& targetExamples,
 				 OneShotTrainingParams const& regressionTrainingParams,
 				 std::vector<T>& LeaveOneOutValues,
 				 T const& trainingError,
 				 std::tuple<ModifierFunctionTypes...> const& modifierFunctions);
 
+			 // appends the number of values to try of each parameter, in the order IterateRegressionParams nests them
+			 static void AppendRegressionParamsAxes(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+				 std::vector<size_t>& numValuesPerAxis);
+
 			 static void IterateRegressionParams(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 				 std::vector<OneShotTrainingParams>& regressionParamSets);
 
@@ -94,12 +105,19 @@ namespace Regressors
 				 col_vector<T>& upperBound,
 				 std::vector<bool>& isIntegerParam,
 				 FindMinGlobalTrainingParams const& fmgTrainingParams,
-				 std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				 std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				 size_t& paramsOffset);
 
 			 template <size_t TotalNumParams>
 			 static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				 std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap);
+				 std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap);
+
+			 static void SerializeCacheKey(OneShotTrainingParams const& regressionTrainingParams,
+				 std::ostream& out);
+
+			 static size_t EstimatePeakMemory(OneShotTrainingParams const& regressionTrainingParams,
+			 	size_t const numExamples,
+			 	size_t const numOrdinates);
 		};
 
 		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -112,10 +130,13 @@ namespace Regressors
 			typedef typename KernelType::SampleType SampleType;
 			typedef typename KernelType::SampleType::type T;
 			typedef dlib::decision_function<typename KernelType::KernelFunctionType> DecisionFunction;
+			typedef KernelExpansion<KernelType> KernelExpansionType;
 
 			SupportVectorRegression() = delete;
 			size_t static const NumTotalParams;
 			size_t static const NumRegressionParams;
+			bool static const ProvidesLeaveOneOutValues;
+			bool static const ProvidesOutOfBagValues;
 
 			struct OneShotTrainingParams : public RegressorTrainer::RegressionOneShotTrainingParamsBase
 			{
@@ -129,7 +150,7 @@ namespace Regressors
 
 				template <size_t TotalNumParams>
 				OneShotTrainingParams(col_vector<T> const& vecParams,
-					std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+					std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 					size_t& paramsOffset);
 
 				ERegressorTypes GetRegressionType() const override;
@@ -168,10 +189,13 @@ namespace Regressors
 			{
 				T LowerC;
 				T UpperC;
+				EParameterScale CScale;
 				T LowerEpsilon;
 				T UpperEpsilon;
+				EParameterScale EpsilonScale;
 				T LowerEpsilonInsensitivity;
 				T UpperEpsilonInsensitivity;
+				EParameterScale EpsilonInsensitivityScale;
 				long LowerCacheSize;
 				long UpperCacheSize;
 				typename KernelType::FindMinGlobalTrainingParams KernelFindMinGlobalTrainingParams;
@@ -179,14 +203,18 @@ namespace Regressors
 				FindMinGlobalTrainingParams();
 			};
 
-			template <class... ModifierFunctionTypes>
-			static impl<SupportVectorRegression, ModifierFunctionTypes...> Train(std::vector<SampleType> const& inputExamples,
-				std::vector<T> const& targetExamples,
+			template <class SampleContainerType, class TargetContainerType, class... ModifierFunctionTypes>
+			static impl<SupportVectorRegression, ModifierFunctionTypes...> Train(SampleContainerType const& inputExamples,
+				TargetContainerType const& targetExamples,
 				OneShotTrainingParams const& regressionTrainingParams,
 				std::vector<T>& Residuals,
 				T const& trainingError,
 				std::tuple<ModifierFunctionTypes...> const& modifierFunctions);
 
+			// appends the number of values to try of each parameter, in the order IterateRegressionParams nests them
+			static void AppendRegressionParamsAxes(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			static void IterateRegressionParams(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 				std::vector<OneShotTrainingParams>& regressionParamSets);
 
@@ -195,12 +223,19 @@ namespace Regressors
 				col_vector<T>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap);
+				std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap);
+
+			static void SerializeCacheKey(OneShotTrainingParams const& regressionTrainingParams,
+				std::ostream& out);
+
+			static size_t EstimatePeakMemory(OneShotTrainingParams const& regressionTrainingParams,
+				size_t const numExamples,
+				size_t const numOrdinates);
 		};
 
 		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -213,10 +248,13 @@ namespace Regressors
 			typedef typename ExtractorType::SampleType SampleType;
 			typedef typename ExtractorType::SampleType::type T;
 			typedef dlib::random_forest_regression_function<typename ExtractorType::ExtractorFunctionType> DecisionFunction;
+			typedef NoKernelExpansion KernelExpansionType;
 
 			RandomForestRegression() = delete;
 			size_t static const NumTotalParams;
 			size_t static const NumRegressionParams;
+			bool static const ProvidesLeaveOneOutValues;
+			bool static const ProvidesOutOfBagValues;
 
 			struct OneShotTrainingParams : public RegressorTrainer::RegressionOneShotTrainingParamsBase
 			{
@@ -229,7 +267,7 @@ namespace Regressors
 
 				template <size_t TotalNumParams>
 				OneShotTrainingParams(col_vector<T> const& vecParams,
-					std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+					std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 					size_t& paramsOffset);
 
 				ERegressorTypes GetRegressionType() const override;
@@ -269,19 +307,24 @@ namespace Regressors
 				size_t UpperMinSamplesPerLeaf;
 				T LowerSubsamplingFraction;
 				T UpperSubsamplingFraction;
+				EParameterScale SubsamplingFractionScale;
 				typename ExtractorType::FindMinGlobalTrainingParams ExtractorFindMinGlobalTrainingParams;
 
 				FindMinGlobalTrainingParams();
 			};
 
-			template <class... ModifierFunctionTypes>
-			static impl<RandomForestRegression, ModifierFunctionTypes...> Train(std::vector<SampleType> const& inputExamples,
-				std::vector<T> const& targetExamples,
+			template <class SampleContainerType, class TargetContainerType, class... ModifierFunctionTypes>
+			static impl<RandomForestRegression, ModifierFunctionTypes...> Train(SampleContainerType const& inputExamples,
+				TargetContainerType const& targetExamples,
 				OneShotTrainingParams const& regressionTrainingParams,
 				std::vector<T>& OutOfBagValues,
 				T const& trainingError,
 				std::tuple<ModifierFunctionTypes...> const& modifierFunctions);
 
+			// appends the number of values to try of each parameter, in the order IterateRegressionParams nests them
+			static void AppendRegressionParamsAxes(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			static void IterateRegressionParams(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 				std::vector<OneShotTrainingParams>& regressionParamSets);
 
@@ -290,12 +333,19 @@ namespace Regressors
 				col_vector<T>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap);
+				std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap);
+
+			static void SerializeCacheKey(OneShotTrainingParams const& regressionTrainingParams,
+				std::ostream& out);
+
+			static size_t EstimatePeakMemory(OneShotTrainingParams const& regressionTrainingParams,
+				size_t const numExamples,
+				size_t const numOrdinates);
 		};
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -310,10 +360,13 @@ namespace Regressors
 			typedef typename KernelType::SampleType SampleType;
 			typedef typename KernelType::SampleType::type T;
 			typedef GKMDecisionFunction<LinkFunctionType> DecisionFunction;
+			typedef NoKernelExpansion KernelExpansionType;
 
 			IterativelyReweightedLeastSquaresRegression() = delete;
 			size_t static const NumTotalParams;
 			size_t static const NumRegressionParams;
+			bool static const ProvidesLeaveOneOutValues;
+			bool static const ProvidesOutOfBagValues;
 
 			struct OneShotTrainingParams : public RegressorTrainer::RegressionOneShotTrainingParamsBase
 			{
@@ -329,7 +382,7 @@ namespace Regressors
 
 				template <size_t TotalNumParams>
 				OneShotTrainingParams(col_vector<T> const& vecParams,
-					std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+					std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 					size_t& paramsOffset);
 
 				ERegressorTypes GetRegressionType() const override;
@@ -373,24 +426,30 @@ namespace Regressors
 				size_t UpperMaxNumIterations;
 				T LowerConvergenceTolerance;
 				T UpperConvergenceTolerance;
+				EParameterScale ConvergenceToleranceScale;
 				unsigned long LowerMaxBasisFunctions;
 				unsigned long UpperMaxBasisFunctions;
 				T LowerLambda;
 				T UpperLambda;
+				EParameterScale LambdaScale;
 				typename LinkFunctionType::FindMinGlobalTrainingParams LinkFunctionFindMinGlobalTrainingParams;
 				typename KernelType::FindMinGlobalTrainingParams KernelFindMinGlobalTrainingParams;
 
 				FindMinGlobalTrainingParams();
 			};
 
-			template <class... ModifierFunctionTypes>
-			static impl<IterativelyReweightedLeastSquaresRegression, ModifierFunctionTypes...> Train(std::vector<SampleType> const& inputExamples,
-				std::vector<T> const& targetExamples,
+			template <class SampleContainerType, class TargetContainerType, class... ModifierFunctionTypes>
+			static impl<IterativelyReweightedLeastSquaresRegression, ModifierFunctionTypes...> Train(SampleContainerType const& inputExamples,
+				TargetContainerType const& targetExamples,
 				OneShotTrainingParams const& regressionTrainingParams,
 				std::vector<T>& Residuals,
 				T const& trainingError,
 				std::tuple<ModifierFunctionTypes...> const& modifierFunctions);
 
+			// appends the number of values to try of each parameter, in the order IterateRegressionParams nests them
+			static void AppendRegressionParamsAxes(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+				std::vector<size_t>& numValuesPerAxis);
+
 			static void IterateRegressionParams(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 				std::vector<OneShotTrainingParams>& regressionParamSets);
 
@@ -399,12 +458,19 @@ namespace Regressors
 				col_vector<T>& upperBound,
 				std::vector<bool>& isIntegerParam,
 				FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+				std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 				size_t& paramsOffset);
 
 			template <size_t TotalNumParams>
 			static void ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-				std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap);
+				std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap);
+
+			static void SerializeCacheKey(OneShotTrainingParams const& regressionTrainingParams,
+				std::ostream& out);
+
+			static size_t EstimatePeakMemory(OneShotTrainingParams const& regressionTrainingParams,
+				size_t const numExamples,
+				size_t const numOrdinates);
 		};
 
 		template <class KernelType>
@@ -412,6 +478,10 @@ namespace Regressors
 		template <class KernelType>
 		size_t const KernelRidgeRegression<KernelType>::NumTotalParams = NumRegressionParams + KernelType::NumKernelParams;
 		template <class KernelType>
+		bool const KernelRidgeRegression<KernelType>::ProvidesLeaveOneOutValues = true;
+		template <class KernelType>
+		bool const KernelRidgeRegression<KernelType>::ProvidesOutOfBagValues = false;
+		template <class KernelType>
 		ERegressorTypes const KernelRidgeRegression<KernelType>::RegressorTypeEnum =
 			std::is_same<KernelType, KernelTypes::LinearKernel<typename KernelType::SampleType>>::value ? ERegressorTypes::LinearKernelRidgeRegression :
 			std::is_same<KernelType, KernelTypes::PolynomialKernel<typename KernelType::SampleType>>::value ? ERegressorTypes::PolynomialKernelRidgeRegression :
@@ -424,6 +494,10 @@ namespace Regressors
 		template <class KernelType>
 		size_t const SupportVectorRegression<KernelType>::NumTotalParams = NumRegressionParams + KernelType::NumKernelParams;
 		template <class KernelType>
+		bool const SupportVectorRegression<KernelType>::ProvidesLeaveOneOutValues = false;
+		template <class KernelType>
+		bool const SupportVectorRegression<KernelType>::ProvidesOutOfBagValues = false;
+		template <class KernelType>
 		ERegressorTypes const SupportVectorRegression<KernelType>::RegressorTypeEnum =
 			std::is_same<KernelType, KernelTypes::LinearKernel<typename KernelType::SampleType>>::value ? ERegressorTypes::LinearSupportVectorRegression :
 			std::is_same<KernelType, KernelTypes::PolynomialKernel<typename KernelType::SampleType>>::value ? ERegressorTypes::PolynomialSupportVectorRegression :
@@ -436,6 +510,10 @@ namespace Regressors
 		template <class ExtractorType>
 		size_t const RandomForestRegression<ExtractorType>::NumTotalParams = NumRegressionParams + ExtractorType::NumExtractorParams;
 		template <class ExtractorType>
+		bool const RandomForestRegression<ExtractorType>::ProvidesLeaveOneOutValues = false;
+		template <class ExtractorType>
+		bool const RandomForestRegression<ExtractorType>::ProvidesOutOfBagValues = true;
+		template <class ExtractorType>
 		ERegressorTypes const RandomForestRegression<ExtractorType>::RegressorTypeEnum =
 			std::is_same<ExtractorType, KernelTypes::DenseExtractor<typename ExtractorType::SampleType>>::value ? ERegressorTypes::DenseRandomForestRegression :
 			ERegressorTypes::MAX_NUMBER_OF_ERegressorTypes;
@@ -445,6 +523,10 @@ namespace Regressors
 		template <class LinkFunctionType>
 		size_t const IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::NumTotalParams = NumRegressionParams + LinkFunctionType::NumLinkFunctionParams;
 		template <class LinkFunctionType>
+		bool const IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::ProvidesLeaveOneOutValues = false;
+		template <class LinkFunctionType>
+		bool const IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::ProvidesOutOfBagValues = false;
+		template <class LinkFunctionType>
 		ERegressorTypes const IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::RegressorTypeEnum = ERegressorTypes::MAX_NUMBER_OF_ERegressorTypes;
 	}
 }
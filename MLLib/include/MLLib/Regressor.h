@@ -1,25 +1,27 @@
 #pragma once
+#include <atomic>
 #include <exception>
+#include <future>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <MLLib/FoldPlan.h>
+#include <MLLib/TrainingOptions.h>
+#include <MLLib/PredictionWorkspace.h>
+#include <MLLib/TaskDispatcher.h>
 #include <MLLib/RegressionTypes.h>
 #include <MLLib/KernelTypes.h>
 #include <MLLib/ModifierTypes.h>
 #include <MLLib/LinkFunctionTypes.h>
 #include <dlib/random_forest.h>
+#include <dlib/statistics.h>
 
 namespace Regressors
 {
-	enum class ECrossValidationMetric
-	{
-		SumAbsoluteMax,
-		SumAbsoluteMean,
-		SumSquareMax,
-		SumSquareMean,
-		CovarianceCorrelation
-	};
-
 	DECLARE_ENUM(ERegressorTypes,
 		LinearKernelRidgeRegression,
 		PolynomialKernelRidgeRegression,
@@ -49,6 +51,13 @@ namespace Regressors
 			RegressorError(const std::string& message) : dlib::error(message) {}
 		};
 
+		// thrown when a deadline or cancellation stops a training run before it has scored any parameter set, leaving no
+		// best parameter set to train
+		struct TrainingStoppedError : public RegressorError
+		{
+			TrainingStoppedError(const std::string& message) : RegressorError(message) {}
+		};
+
 		struct RegressionOneShotTrainingParamsBase
 		{
 		public:
@@ -70,7 +79,8 @@ namespace Regressors
 		public:
 			typedef typename SampleType::type T;
 
-			virtual T Predict(SampleType input) const = 0;
+			virtual T Predict(SampleType const& input, PredictionWorkspace<SampleType>& workspace) const = 0;
+			virtual void PredictBatch(SampleType const* inputs, T* outputs, size_t const numSamples, dlib::thread_pool* const tp) const = 0;
 			virtual T const& GetTrainingError() const = 0;
 			virtual typename RegressorTrainer::RegressionOneShotTrainingParamsBase const& GetTrainedRegressorParams() const = 0;
 			virtual constexpr size_t GetNumModifiers() const = 0;
@@ -86,40 +96,183 @@ namespace Regressors
 			static typename RegressorTrainer::ModifierOneShotTrainingParamsBase const& GetModifierTrainingParams(size_t const index,
 				std::tuple<ModifierFunctionTypes...> const& modifierFunctions);
 
+			// returns the input after every modifier, held in the modifier's own output buffer
 			template <size_t I = 0, class... ModifierFunctionTypes>
-			static void ApplyModifiers(std::tuple<ModifierFunctionTypes...> const& modifierFunctions,
-				SampleType& input);
+			static SampleType const& ApplyModifiers(std::tuple<ModifierFunctionTypes...> const& modifierFunctions,
+				SampleType const& input,
+				std::vector<SampleType>& modifierOutputs);
+		};
+
+		// The training examples of one cross-validation fold after a given set of modifiers has been trained on and applied
+		// to them. Grid searches share one per (fold, modifier parameter set) across every regression parameter set, and
+		// release it once the last of those sets has been scored.
+		template <typename SampleType, class... ModifierFunctionTypes>
+		struct ModifiedFold
+		{
+			std::once_flag Prepared;
+			bool IsPrepared = false;
+			std::tuple<ModifierFunctionTypes...> ModifierFunctions;
+			std::vector<SampleType> Examples;
+			std::vector<typename SampleType::type> Targets;
+		};
+
+		// Shared by every candidate of a raced cross-validation grid. Candidates that are stopped early score +infinity, so
+		// they are never selected or cached.
+		template <typename T>
+		struct RaceState
+		{
+			ERacingRule Rule;
+			T Confidence;
+			size_t MinFolds;
+			std::atomic<T> BestScore;
+			std::atomic<size_t> NumPruned;
 		};
 
 		template <class RegressionType, class... ModifierOneShotParamsTypes>
 		static typename RegressionType::SampleType::type CrossValidate(const std::vector<typename RegressionType::SampleType>& inputExamples,
 			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
-			std::string const& randomSeed,
+			FoldPlan const& foldPlan,
 			typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
-			size_t const numFolds,
 			ECrossValidationMetric const metric,
-			std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams);
+			std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			ModifiedFold<typename RegressionType::SampleType, typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...>* const modifiedFolds,
+			RaceState<typename RegressionType::SampleType::type>* const race,
+			CrossValidationReport<typename RegressionType::SampleType::type>& report,
+			dlib::thread_pool& tp);
+
+		template <class RegressionType, class... ModifierOneShotParamsTypes>
+		static impl<RegressionType, typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...> TrainOnModifiedFold(IndexedVectorView<typename RegressionType::SampleType> const& foldTrainExamples,
+			IndexedVectorView<typename RegressionType::SampleType::type> const& foldTrainTargets,
+			typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+			std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams,
+			ModifiedFold<typename RegressionType::SampleType, typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...>& modifiedFold);
+
+		template <typename T>
+		static bool IsOutOfRace(RaceState<T> const& race,
+			dlib::running_stats<T> const& completedFoldScores,
+			size_t const numFolds);
+
+		template <typename T>
+		static void RecordRaceScore(RaceState<T>& race,
+			T const& score);
+
+		// throws TrainingStoppedError if a stop left the run without a scored parameter set
+		template <typename T>
+		static void CheckScoredBeforeStop(TrainingOptions<T> const& options,
+			T const& bestTrainingError);
+
+		// copies the selected candidate's report, and every candidate's, to the outputs the options request
+		template <typename T>
+		static void WriteReports(TrainingOptions<T> const& options,
+			std::vector<CrossValidationReport<T>> const& candidateReports,
+			size_t const bestIndex);
+
+		template <typename T>
+		static dlib::thread_pool& AcquireThreadPool(TrainingOptions<T> const& options,
+			std::unique_ptr<dlib::thread_pool>& ownedThreadPool);
+
+		template <class RegressionType, class TrainFunctionType>
+		static std::future<Regressor<typename RegressionType::SampleType>> TrainAsync(TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			TrainFunctionType const& train);
+
+		template <class RegressionType>
+		static std::string GetCacheContextKey(std::vector<typename RegressionType::SampleType> const& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			ECrossValidationStrategy const strategy);
+
+		template <class RegressionType, class... ModifierOneShotParamsTypes>
+		static typename RegressionType::SampleType::type ScoreSingleFit(std::vector<typename RegressionType::SampleType> const& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+			ECrossValidationMetric const metric,
+			ECrossValidationStrategy const strategy,
+			std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams,
+			CrossValidationReport<typename RegressionType::SampleType::type>& report);
+
+		template <typename T>
+		static T GetCrossValidationMetric(ECrossValidationMetric const metric,
+			CrossValidationMetrics<T> const& metrics);
+
+		template <class RegressionType, class... ModifierOneShotParamsTypes>
+		static typename RegressionType::SampleType::type CrossValidateWithCache(std::vector<typename RegressionType::SampleType> const& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+			ECrossValidationMetric const metric,
+			std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::string const& cacheContextKey,
+			ModifiedFold<typename RegressionType::SampleType, typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...>* const modifiedFolds,
+			RaceState<typename RegressionType::SampleType::type>* const race,
+			CrossValidationReport<typename RegressionType::SampleType::type>* const report,
+			dlib::thread_pool& tp);
 
 		template <class RegressionType, class... ModifierOneShotTrainingTypes>
 		static void CrossValidateTrainingParameterSets(std::vector<typename RegressionType::SampleType> const& inputExamples,
 			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
-			std::string const& randomSeed,
+			FoldPlan const& foldPlan,
 			std::vector<typename RegressionType::OneShotTrainingParams> const& regressionTrainingParamsToTry,
 			std::vector<std::tuple<ModifierOneShotTrainingTypes...>>& modifierTrainingParamsToTry,
-			size_t const numFolds,
 			ECrossValidationMetric const metric,
 			std::vector<std::pair<std::pair<size_t, size_t>, typename RegressionType::SampleType::type>>& allCrossValidatedRegressors,
+			std::vector<CrossValidationReport<typename RegressionType::SampleType::type>>& candidateReports,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::string const& cacheContextKey,
 			dlib::thread_pool& tp);
 
+		template <class RegressionType, class... ModifierOneShotTrainingTypes>
+		static void CrossValidateCandidates(std::vector<typename RegressionType::SampleType> const& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			std::vector<typename RegressionType::OneShotTrainingParams> const& regressionTrainingParamsToTry,
+			std::vector<std::tuple<ModifierOneShotTrainingTypes...>> const& modifierTrainingParamsToTry,
+			std::vector<std::pair<size_t, size_t>> const& candidates,
+			ECrossValidationMetric const metric,
+			std::vector<typename RegressionType::SampleType::type>& candidateTrainingErrors,
+			std::vector<CrossValidationReport<typename RegressionType::SampleType::type>>& candidateReports,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::string const& cacheContextKey,
+			dlib::thread_pool& tp);
+
+		// numValuesPerAxis lists the number of values to try of each parameter, outermost first, as the grid nests them
+		static std::vector<std::pair<size_t, size_t>> SampleCandidates(size_t const numRegressionParams,
+			size_t const numModifierParams,
+			std::vector<size_t> const& regressionNumValuesPerAxis,
+			std::vector<size_t> const& modifierNumValuesPerAxis,
+			size_t const numSamples,
+			RandomStream stream);
+
+		template <typename T, class ObjectiveFunctionType>
+		static dlib::function_evaluation FindMinGlobal(ObjectiveFunctionType const& objective,
+			col_vector<T> const& lowerBound,
+			col_vector<T> const& upperBound,
+			std::vector<bool> const& isIntegerParam,
+			size_t const maxNumCalls,
+			T const& optimisationTolerance,
+			TrainingOptions<T> const& options,
+			std::string const& checkpointFingerprint,
+			dlib::thread_pool& tp);
+
+		static void LoadCheckpoint(std::string const& checkpointPath,
+			std::string const& checkpointFingerprint,
+			std::vector<dlib::function_evaluation>& evaluations);
+
+		static void SaveCheckpoint(std::string const& checkpointPath,
+			std::string const& checkpointFingerprint,
+			std::vector<dlib::function_evaluation> const& evaluations);
+
 		template <size_t I, class... ModifierFindMinGlobalTrainingTypes>
 		static constexpr size_t GetNumModifierParams();
 
 		template <typename T, size_t TotalNumParams>
-		static void ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+		static void ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 			size_t const offset);
 
 		template <typename T, size_t TotalNumParams, class... ModifierFindMinGlobalTrainingTypes, class ModifierFindMinGlobalTrainingType>
-		static void ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+		static void ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 			size_t const offset,
 			ModifierFindMinGlobalTrainingType const& first,
 			ModifierFindMinGlobalTrainingTypes const&... rest);
@@ -128,7 +281,7 @@ namespace Regressors
 		static void PackageModifierParams(col_vector<T>& lowerBound,
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset);
 
@@ -136,7 +289,7 @@ namespace Regressors
 		static void PackageModifierParams(col_vector<T>& lowerBound,
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset,
 			ModifierFindMinGlobalTrainingType const& first,
@@ -145,26 +298,32 @@ namespace Regressors
 		template <typename T, size_t TotalNumParams, class... ModifierOneShotTrainingParams>
 		static void UnpackModifierParams(std::tuple<ModifierOneShotTrainingParams...>& modifierOneShotTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset);
 
 		template <typename T, size_t TotalNumParams>
-		static void ProcessModifierFindMinGlobalParameterPack(std::array<std::pair<bool, T>, TotalNumParams> optimiseParamsMap);
+		static void ProcessModifierFindMinGlobalParameterPack(std::array<ParameterMapping<T>, TotalNumParams> optimiseParamsMap);
 
 		template <typename T, size_t TotalNumParams, class ModifierFindMinGlobalTrainingType, class... ModifierFindMinGlobalTrainingTypes>
-		static void ProcessModifierFindMinGlobalParameterPack(std::array<std::pair<bool, T>, TotalNumParams> optimiseParamsMap,
+		static void ProcessModifierFindMinGlobalParameterPack(std::array<ParameterMapping<T>, TotalNumParams> optimiseParamsMap,
 			ModifierFindMinGlobalTrainingType const& first,
 			ModifierFindMinGlobalTrainingTypes const&... rest);
 
-		template <class RegressionType, size_t I = 0, class... ModifierOneShotTrainingParamsTypes>
-		static impl<RegressionType, typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...> TrainModifiersAndRegressor(std::vector<typename RegressionType::SampleType> const& inputExamples,
-			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		template <class RegressionType, class SampleContainerType, class TargetContainerType, class... ModifierOneShotTrainingParamsTypes>
+		static impl<RegressionType, typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...> TrainModifiersAndRegressor(SampleContainerType const& inputExamples,
+			TargetContainerType const& targetExamples,
 			typename RegressionType::OneShotTrainingParams const& regressionParams,
 			std::vector<typename RegressionType::SampleType::type>& diagnostics,
 			typename RegressionType::SampleType::type const& trainingError,
 			std::tuple<ModifierOneShotTrainingParamsTypes...> const& modifierOneShotParams,
 			std::tuple<typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...>& modifierFunctions);
+
+		template <size_t I, typename SampleType, class... ModifierOneShotTrainingParamsTypes>
+		static void TrainModifiers(std::vector<SampleType>& examples,
+			std::vector<typename SampleType::type> const& targetExamples,
+			std::tuple<ModifierOneShotTrainingParamsTypes...> const& modifierOneShotParams,
+			std::tuple<typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...>& modifierFunctions);
 		
 		template <class... ModifierCrossValidationTrainingTypes>
 		static void IterateModifiers(std::tuple<ModifierCrossValidationTrainingTypes...> const& modifiersCrossValidationTrainingParams,
@@ -178,6 +337,16 @@ namespace Regressors
 			}
 		}
 
+		template <class... ModifierCrossValidationTrainingTypes>
+		static void AppendModifiersAxes(std::tuple<ModifierCrossValidationTrainingTypes...> const& modifiersCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			std::apply([&](auto const&... modifierCrossValidationTrainingParams)
+				{
+					(std::decay_t<decltype(modifierCrossValidationTrainingParams)>::ModifierType::AppendModifierParamsAxes(modifierCrossValidationTrainingParams, numValuesPerAxis), ...);
+				}, modifiersCrossValidationTrainingParams);
+		}
+
 	public:
 
 		template <class RegressionType, class... ModifierOneShotTrainingTypes>
@@ -190,6 +359,27 @@ namespace Regressors
 			typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
 			ModifierOneShotTrainingTypes const&... modifiersOneShotTrainingPack);
 
+		template <class RegressionType, class... ModifierOneShotTrainingTypes>
+		static impl<RegressionType, typename ModifierOneShotTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorOneShot(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			std::string const& randomSeed,
+			ECrossValidationMetric const metric,
+			size_t const numFolds,
+			size_t const numThreads,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+			ModifierOneShotTrainingTypes const&... modifiersOneShotTrainingPack);
+
+		template <class RegressionType, class... ModifierOneShotTrainingTypes>
+		static impl<RegressionType, typename ModifierOneShotTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorOneShot(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+			ModifierOneShotTrainingTypes const&... modifiersOneShotTrainingPack);
+
 		template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
 		static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorCrossValidation(const std::vector<typename RegressionType::SampleType>& inputExamples,
 			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
@@ -201,6 +391,81 @@ namespace Regressors
 			typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 			ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack);
 
+		template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+		static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorCrossValidation(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack);
+
+		template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+		static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorSuccessiveHalving(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			std::string const& randomSeed,
+			ECrossValidationMetric const metric,
+			size_t const numFolds,
+			size_t const numThreads,
+			size_t const reductionFactor,
+			size_t const minNumExamples,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack);
+
+		// Every parameter set of the grid is first cross-validated on a prefix of the fold plan's shuffled examples. Only the
+		// best 1 / reductionFactor of them are carried forward to a prefix reductionFactor times larger, until the survivors
+		// are cross-validated on the full plan. The smallest prefix holds at least minNumExamples examples.
+		template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+		static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorSuccessiveHalving(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			size_t const reductionFactor,
+			size_t const minNumExamples,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack);
+
+		template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+		static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorRandomSearch(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			std::string const& randomSeed,
+			ECrossValidationMetric const metric,
+			size_t const numFolds,
+			size_t const numThreads,
+			size_t const numSamples,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack);
+
+		// At most numSamples parameter sets of the grid are cross-validated rather than all of them. They are drawn by Latin
+		// hypercube sampling over every parameter's values to try with the fold plan's random stream, so that each parameter
+		// is covered evenly and, when the budget is at least its number of values, completely. Samples that land on the same
+		// grid point are replaced by uniformly drawn unsampled ones; a budget at least as large as the grid cross-validates
+		// the whole grid.
+		template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+		static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorRandomSearch(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			size_t const numSamples,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack);
+
+		// The regression and modifier parameter sets that TrainRegressorRandomSearch cross-validates for the same fold plan
+		// and budget, in the order it scores them.
+		template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+		static std::vector<std::pair<typename RegressionType::OneShotTrainingParams, std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>> GetRandomSearchCandidates(FoldPlan const& foldPlan,
+			size_t const numSamples,
+			typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack);
+
+		// One candidate point per thread is proposed and cross-validated together on each optimiser step.
 		template <class RegressionType, class... ModifierFindMinGlobalTrainingTypes>
 		static impl<RegressionType, typename ModifierFindMinGlobalTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorFindMinGlobal(const std::vector<typename RegressionType::SampleType>& inputExamples,
 			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
@@ -213,6 +478,57 @@ namespace Regressors
 			std::vector<typename RegressionType::SampleType::type>& diagnostics,
 			typename RegressionType::FindMinGlobalTrainingParams const& regressionFindMinGlobalTrainingParams,
 			ModifierFindMinGlobalTrainingTypes const&... modifiersFindMinGlobalTrainingPack);
+
+		// options.NumConcurrentEvaluations candidate points are proposed and cross-validated together on each optimiser step.
+		// The search is reproducible for a given fold plan and batch size; a batch size of one reproduces dlib's serial search.
+		template <class RegressionType, class... ModifierFindMinGlobalTrainingTypes>
+		static impl<RegressionType, typename ModifierFindMinGlobalTrainingTypes::ModifierType::ModifierFunction...> TrainRegressorFindMinGlobal(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			typename RegressionType::SampleType::type const& optimisationTolerance,
+			size_t const maxNumCalls,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::FindMinGlobalTrainingParams const& regressionFindMinGlobalTrainingParams,
+			ModifierFindMinGlobalTrainingTypes const&... modifiersFindMinGlobalTrainingPack);
+
+		// The asynchronous entry points queue the training as a single task on options.ThreadPool, or on
+		// dlib::default_thread_pool() when none is given, and return at once, however busy the pool is; the queue is
+		// unbounded. The task's folds and parameter sets are then trained on the worker that runs it, so many queued
+		// trainings are packed onto the pool's threads rather than each needing its own. The examples, fold plan,
+		// diagnostics and any outputs named in options must outlive the future, and the pool must outlive the training.
+		template <class RegressionType, class... ModifierOneShotTrainingTypes>
+		static std::future<Regressor<typename RegressionType::SampleType>> TrainRegressorOneShotAsync(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+			ModifierOneShotTrainingTypes const&... modifiersOneShotTrainingPack);
+
+		template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+		static std::future<Regressor<typename RegressionType::SampleType>> TrainRegressorCrossValidationAsync(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack);
+
+		template <class RegressionType, class... ModifierFindMinGlobalTrainingTypes>
+		static std::future<Regressor<typename RegressionType::SampleType>> TrainRegressorFindMinGlobalAsync(const std::vector<typename RegressionType::SampleType>& inputExamples,
+			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+			FoldPlan const& foldPlan,
+			ECrossValidationMetric const metric,
+			typename RegressionType::SampleType::type const& optimisationTolerance,
+			size_t const maxNumCalls,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::vector<typename RegressionType::SampleType::type>& diagnostics,
+			typename RegressionType::FindMinGlobalTrainingParams const& regressionFindMinGlobalTrainingParams,
+			ModifierFindMinGlobalTrainingTypes const&... modifiersFindMinGlobalTrainingPack);
 	};
 
 	template <typename SampleType>
@@ -243,7 +559,13 @@ namespace Regressors
 		template <class RegressionType, class... ModifierFunctionTypes>
 		Regressor(impl<RegressionType, ModifierFunctionTypes...>&& regressor);
 
+		// predicts through the calling thread's workspace, without heap allocation once it has been sized
 		T Predict(SampleType const& input) const;
+		T Predict(SampleType const& input, PredictionWorkspace<SampleType>& workspace) const;
+		// predicts numSamples contiguous inputs into outputs with a single dispatch to the trained regressor; when given a
+		// pool, large batches are split into blocks predicted concurrently on it
+		void PredictBatch(SampleType const* inputs, T* outputs, size_t const numSamples, dlib::thread_pool* const tp = nullptr) const;
+		std::vector<T> PredictBatch(std::vector<SampleType> const& inputs, dlib::thread_pool* const tp = nullptr) const;
 		typename RegressorTrainer::RegressionOneShotTrainingParamsBase const& GetTrainedRegressorParams() const;
 		constexpr size_t GetNumModifiers() const;
 		typename RegressorTrainer::ModifierOneShotTrainingParamsBase const& GetTrainedModifierParams(size_t const index) const;
@@ -274,6 +596,10 @@ namespace Regressors
 	{
 	public:
 		static size_t const MaxNumModifiers;
+		// smallest batch that PredictBatch splits across a thread pool; below it the hand-off costs more than it saves
+		static size_t const MinParallelBatchSize;
+		// samples that PredictBatch passes together through the fused modifiers and the kernel expansion
+		static size_t const BatchChunkSize;
 
 	private:
 		typedef typename RegressionType::SampleType SampleType;
@@ -282,9 +608,22 @@ namespace Regressors
 		typename RegressionType::OneShotTrainingParams TrainedRegressorParams;
 		typename RegressionType::DecisionFunction Function;
 		std::tuple<ModifierFunctionTypes...> ModifierFunctions;
+		// the modifier chain composed into one affine map, output = FusedMatrix * input + FusedOffset, for chains with a
+		// modifier that mixes ordinates; built on construction and deserialisation and never serialised
+		bool HasFusedModifiers;
+		dlib::matrix<T> FusedMatrix;
+		col_vector<T> FusedOffset;
+		// the decision function repacked for prediction, for kernel regressors; built alongside the fused modifiers
+		static constexpr bool HasKernelExpansion = !std::is_same<typename RegressionType::KernelExpansionType, NoKernelExpansion>::value;
+		typename RegressionType::KernelExpansionType Expansion;
 
 	public:
-		T Predict(SampleType input) const override;
+		T Predict(SampleType const& input) const;
+		T Predict(SampleType const& input, PredictionWorkspace<SampleType>& workspace) const override;
+		// applies each modifier in turn rather than the fused map, so its result does not depend on whether the chain
+		// could be fused; cross-validation scores folds with it
+		T PredictThroughModifiers(SampleType const& input, PredictionWorkspace<SampleType>& workspace) const;
+		void PredictBatch(SampleType const* inputs, T* outputs, size_t const numSamples, dlib::thread_pool* const tp) const override;
 		typename RegressionType::OneShotTrainingParams const& GetTrainedRegressorParams() const override;
 		constexpr size_t GetNumModifiers() const override;
 		typename RegressorTrainer::ModifierOneShotTrainingParamsBase const& GetTrainedModifierParams(size_t const index) const override;
@@ -312,10 +651,27 @@ namespace Regressors
 
 	private:
 		void Serialize(std::ostream& out) const override;
+
+		void PreparePrediction();
+
+		void FuseModifiers();
+
+		template <size_t I = 0>
+		void ComposeModifiers(long const numInputs);
+
+		void ApplyFusedModifiers(SampleType const& input, SampleType& output) const;
+
+		T EvaluateDecisionFunction(SampleType const& modifiedInput) const;
 	};
 
 	template <class RegressorType, class... ModifierFunctionTypes>
 	size_t const impl<RegressorType, ModifierFunctionTypes...>::MaxNumModifiers = 5ull;
+
+	template <class RegressorType, class... ModifierFunctionTypes>
+	size_t const impl<RegressorType, ModifierFunctionTypes...>::MinParallelBatchSize = 1024ull;
+
+	template <class RegressorType, class... ModifierFunctionTypes>
+	size_t const impl<RegressorType, ModifierFunctionTypes...>::BatchChunkSize = 64ull;
 }
 
 #include "impl/Regressor.hpp"
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+#include <dlib/threads.h>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Regressors
+{
+	/*
+	* An unbounded queue in front of a dlib::thread_pool. dlib::thread_pool::add_task blocks a caller that is not one of
+	* the pool's workers until a thread is free, so code that must never wait for the pool hands its tasks here instead.
+	* Each pool is given one dispatcher, which moves its queued tasks onto the pool in submission order from a thread of
+	* its own; that thread only exists while tasks are waiting to be moved.
+	*
+	* Tasks still queued for a pool when it is destroyed are never run, so a pool must outlive every task submitted to it.
+	*/
+	class TaskDispatcher
+	{
+	public:
+		// queues task to run on tp and returns without waiting for one of the pool's threads to become free
+		static void Submit(dlib::thread_pool& tp,
+			std::function<void()> task);
+
+		TaskDispatcher(TaskDispatcher const&) = delete;
+		TaskDispatcher& operator=(TaskDispatcher const&) = delete;
+
+		~TaskDispatcher();
+
+	private:
+		explicit TaskDispatcher(dlib::thread_pool& tp);
+
+		static TaskDispatcher& GetDispatcher(dlib::thread_pool& tp);
+
+		void Enqueue(std::function<void()> task);
+
+		void Dispatch();
+
+		dlib::thread_pool& ThreadPool;
+		std::mutex Mutex;
+		std::deque<std::function<void()>> Tasks;
+		bool IsDispatching;
+		std::thread DispatchThread;
+	};
+}
+
+#include "impl/TaskDispatcher.hpp"
@@ -0,0 +1,113 @@
+#pragma once
+#include <MLLib/TypeDefinitions.h>
+#include <MLLib/CrossValidationCache.h>
+#include <MLLib/CrossValidationReport.h>
+#include <MLLib/MemoryBudget.h>
+#include <dlib/threads.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Regressors
+{
+	enum class ECrossValidationStrategy
+	{
+		// each parameter set is trained and tested once per fold of the fold plan
+		KFold,
+		// each parameter set is trained once on every example and scored on the leave-one-out predictions of that fit;
+		// only for regressors that provide them, such as kernel ridge regression
+		AnalyticLOO,
+		// each parameter set is trained once on every example and scored on the out-of-bag predictions of that fit; only
+		// for regressors that provide them, such as random forest regression
+		OutOfBag
+	};
+
+	enum class ERacingRule
+	{
+		// every candidate is cross-validated on all folds
+		Off,
+		// a candidate is stopped once its completed folds alone give a mean error above the best score, which cannot
+		// change the selected model
+		Exact,
+		// a candidate is stopped once a lower confidence bound on its mean fold error is above the best score, which prunes
+		// far more but may discard the true best candidate
+		LowerConfidenceBound
+	};
+
+	/*
+	* Settings that control how a training run is carried out rather than what is learnt. They are accepted alongside a
+	* FoldPlan by the RegressorTrainer entry points; the seeded entry points fill them in from their own arguments.
+	*/
+	template <typename T>
+	struct TrainingOptions
+	{
+		// threads used to train cross-validation folds and to evaluate parameter sets
+		size_t NumThreads;
+		// optional pool to train on instead of a pool of NumThreads threads created for each call, not owned; sharing one
+		// pool, such as dlib::default_thread_pool(), between back to back or concurrent trainings avoids thread start-up
+		// costs and bounds the total number of threads
+		dlib::thread_pool* ThreadPool;
+		// candidate points cross-validated together on each find_min_global step
+		size_t NumConcurrentEvaluations;
+		// optional store of previously computed cross-validation results, not owned
+		CrossValidationCache<T>* Cache;
+		// how each parameter set is scored
+		ECrossValidationStrategy Strategy;
+		// rule used to stop training cross-validation grid candidates that can no longer beat the best completed score;
+		// applies to the SumSquareMean and SumAbsoluteMean metrics only
+		ERacingRule Racing;
+		// standard errors subtracted from a candidate's mean fold error by the LowerConfidenceBound rule
+		T RacingConfidence;
+		// folds a candidate must complete before the LowerConfidenceBound rule may stop it
+		size_t RacingMinFolds;
+		// optional count of the grid candidates that racing stopped early, or of the find_min_global points that
+		// multi-fidelity scoring left on a lower fidelity, written when training finishes, not owned
+		size_t* NumPrunedEvaluations;
+		// optional count of the folds on which a cross-validation grid search trained modifiers, written when training
+		// finishes, not owned; each fold is modified once per modifier parameter set and shared by every regression
+		// parameter set paired with it
+		size_t* NumModifierTrainings;
+		// optional report of the selected parameter set's cross-validation, collected while the search scored it and
+		// written when training finishes, not owned; empty if the selected set was not scored on every example by this
+		// run, such as a find_min_global point reloaded from a checkpoint. Successive halving stopped before its full-data
+		// rung reports the cross-validation of the returned candidate on the largest rung that scored it
+		CrossValidationReport<T>* Report;
+		// optional reports of every parameter set that the search tried on every example, in the order it tried them,
+		// written when training finishes, not owned; sets whose scoring was stopped or raced out have empty reports, and
+		// sets found in the cache have the report of their first scoring, fold timings included
+		std::vector<CrossValidationReport<T>>* CandidateReports;
+		// time after which no further fold or parameter set is started; folds already training run to completion and the
+		// best parameter set scored so far is trained on every example and returned, or, if none was scored, a
+		// RegressorTrainer::TrainingStoppedError is thrown. Successive halving stopped before its full-data rung returns
+		// the best candidate of the largest rung scored, with the error and report from that rung
+		std::chrono::steady_clock::time_point Deadline;
+		// optional flag that stops training in the same way as the deadline once it is set, not owned
+		std::atomic<bool> const* CancellationToken;
+		// optional count of the parameter sets whose score was completed on the full data rather than stopped or left on a
+		// lower fidelity, written when training finishes, not owned
+		size_t* NumCompletedEvaluations;
+		// optional file to which find_min_global searches save every evaluated point; a search over the same data, folds,
+		// metric, regressor and parameter space reloads those points and continues from them instead of re-evaluating them
+		std::string CheckpointPath;
+		// when non-zero, find_min_global scores each point on growing prefixes of the fold plan's shuffled examples, the
+		// smallest holding at least this many, and only moves to the next, MultiFidelityReductionFactor times larger
+		// prefix while the point's score ranks among the best 1 / MultiFidelityReductionFactor of the scores on the same
+		// prefix from earlier batches. A point left on a lower prefix is passed to the optimiser with the worst full-data
+		// score so far, so that the search moves away from it, and still counts against the number of calls
+		size_t MultiFidelityMinNumExamples;
+		// ratio between the sizes of successive prefixes used by multi-fidelity scoring
+		size_t MultiFidelityReductionFactor;
+		// optional limit on the estimated peak memory of the fold and single-fit tasks training at once, not owned; tasks
+		// that would exceed it wait for running tasks to finish, so memory-hungry regressors can still use many threads
+		MemoryBudget* TaskMemoryBudget;
+
+		TrainingOptions();
+
+		bool IsStopRequested() const;
+
+		bool IsReportRequested() const;
+	};
+}
+
+#include "impl/TrainingOptions.hpp"
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+
+namespace Regressors
+{
+	/*
+	* Elementwise transcendental functions over arrays, used by the kernels' prediction path. Doubles are processed four
+	* at a time with AVX2 and FMA or eight at a time with AVX-512F when both the build target and the running CPU support
+	* them, chosen once at run time; otherwise, and for other value types, each value goes through the standard library.
+	*
+	* The vectorised functions are within 2 ULP of std::exp and 4 ULP of std::tanh. Exponentials below the smallest normal
+	* double may be rounded to a neighbouring subnormal, and NaNs are returned unchanged. Every result depends only on its
+	* value and the instruction set, not on its position in the array or on the array's length, so values transformed one
+	* block at a time match values transformed all at once.
+	*/
+	namespace VectorMath
+	{
+		enum class EInstructionSet
+		{
+			Scalar,
+			AVX2,
+			AVX512
+		};
+
+		// the widest instruction set that both this build and the running CPU support, detected on first use
+		EInstructionSet GetInstructionSet();
+
+		// replaces each of numValues values with its exponential
+		template <typename T>
+		void Exp(T* values, size_t const numValues);
+
+		// as above, with an instruction set no wider than GetInstructionSet(); wider sets fall back to it
+		template <typename T>
+		void Exp(T* values, size_t const numValues, EInstructionSet const instructionSet);
+
+		// replaces each of numValues values with its hyperbolic tangent
+		template <typename T>
+		void Tanh(T* values, size_t const numValues);
+
+		// as above, with an instruction set no wider than GetInstructionSet(); wider sets fall back to it
+		template <typename T>
+		void Tanh(T* values, size_t const numValues, EInstructionSet const instructionSet);
+	}
+}
+
+#include "impl/VectorMath.hpp"
@@ -0,0 +1,132 @@
+#pragma once
+#include <dlib/serialize.h>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+
+namespace Regressors
+{
+	template <typename T>
+	CrossValidationCache<T>::CrossValidationCache() :
+		NumHits(0)
+	{
+	}
+
+	template <typename T>
+	CrossValidationCache<T>::CrossValidationCache(std::string const& backingFilePath) :
+		NumHits(0)
+	{
+		// the length of the file up to the end of its last complete record
+		std::uintmax_t completeLength = 0;
+		std::ifstream in(backingFilePath, std::ios::binary);
+		try
+		{
+			if (in && in.peek() != std::ifstream::traits_type::eof())
+			{
+				// records written in any other format cannot be read, so the whole file is discarded
+				std::string format;
+				dlib::deserialize(format, in);
+				if (format != FileFormat)
+				{
+					in.setstate(std::ios::failbit);
+				}
+				else
+				{
+					completeLength = static_cast<std::uintmax_t>(in.tellg());
+				}
+			}
+			while (in && in.peek() != std::ifstream::traits_type::eof())
+			{
+				std::string key;
+				Entry entry;
+				dlib::deserialize(key, in);
+				dlib::deserialize(entry.Result, in);
+				deserialize(entry.Report, in);
+				Entries[key] = std::move(entry);
+				completeLength = static_cast<std::uintmax_t>(in.tellg());
+			}
+		}
+		catch (std::exception const&)
+		{
+			// a run that was interrupted part way through a write leaves a truncated final record, which is ignored, as is
+			// everything after a corrupt record, including one whose string length fails to allocate
+		}
+		bool const exists = in.is_open();
+		in.close();
+
+		// the truncated record is cut off, so that new records follow the last complete one and can be read back
+		if (exists)
+		{
+			std::error_code error;
+			std::uintmax_t const fileLength = std::filesystem::file_size(backingFilePath, error);
+			if (!error && fileLength > completeLength)
+			{
+				std::filesystem::resize_file(backingFilePath, completeLength, error);
+			}
+			if (error)
+			{
+				throw dlib::error("Unable to truncate cross-validation cache file " + backingFilePath + ": " + error.message() + ".");
+			}
+		}
+
+		BackingFile.open(backingFilePath, std::ios::binary | std::ios::app);
+		if (!BackingFile)
+		{
+			throw dlib::error("Unable to open cross-validation cache file " + backingFilePath + ".");
+		}
+		if (completeLength == 0)
+		{
+			dlib::serialize(std::string(FileFormat), BackingFile);
+			BackingFile.flush();
+		}
+	}
+
+	template <typename T>
+	bool CrossValidationCache<T>::Find(std::string const& key, T& result, CrossValidationReport<T>* const report) const
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		auto const it = Entries.find(key);
+		if (it == Entries.end())
+		{
+			return false;
+		}
+		result = it->second.Result;
+		if (report != nullptr)
+		{
+			*report = it->second.Report;
+		}
+		++NumHits;
+		return true;
+	}
+
+	template <typename T>
+	void CrossValidationCache<T>::Insert(std::string const& key, T const& result, CrossValidationReport<T> const& report)
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		if (!Entries.emplace(key, Entry{ result, report }).second)
+		{
+			return;
+		}
+		if (BackingFile.is_open())
+		{
+			dlib::serialize(key, BackingFile);
+			dlib::serialize(result, BackingFile);
+			serialize(report, BackingFile);
+			BackingFile.flush();
+		}
+	}
+
+	template <typename T>
+	size_t CrossValidationCache<T>::GetNumEntries() const
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		return Entries.size();
+	}
+
+	template <typename T>
+	size_t CrossValidationCache<T>::GetNumHits() const
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		return NumHits;
+	}
+}
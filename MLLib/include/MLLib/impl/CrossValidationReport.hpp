@@ -0,0 +1,27 @@
+#pragma once
+#include <limits>
+
+namespace Regressors
+{
+	template <typename T>
+	CrossValidationMetrics<T>::CrossValidationMetrics() :
+		SumAbsoluteMax(std::numeric_limits<T>::quiet_NaN()),
+		SumAbsoluteMean(std::numeric_limits<T>::quiet_NaN()),
+		SumSquareMax(std::numeric_limits<T>::quiet_NaN()),
+		SumSquareMean(std::numeric_limits<T>::quiet_NaN()),
+		CovarianceCorrelation(std::numeric_limits<T>::quiet_NaN())
+	{
+	}
+
+	template <typename T>
+	CrossValidationMetrics<T>::CrossValidationMetrics(dlib::running_stats<T> const& rs_abs,
+		dlib::running_stats<T> const& rs_sq,
+		dlib::running_scalar_covariance<T> const& rs_rc) :
+		SumAbsoluteMax(rs_abs.max()),
+		SumAbsoluteMean(rs_abs.mean()),
+		SumSquareMax(rs_sq.max()),
+		SumSquareMean(rs_sq.mean()),
+		CovarianceCorrelation(rs_rc.current_n() > 1 ? rs_rc.correlation() : std::numeric_limits<T>::quiet_NaN())
+	{
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <dlib/svm.h>
+#include <numeric>
+#include <sstream>
+
+namespace Regressors
+{
+	inline FoldPlan::FoldPlan(std::string const& randomSeed,
+		size_t const numExamples,
+		size_t const numFolds) :
+		ShuffledIndices(numExamples),
+		Stream(randomSeed)
+	{
+		std::iota(ShuffledIndices.begin(), ShuffledIndices.end(), 0);
+		dlib::rand rng(randomSeed);
+		dlib::randomize_samples(ShuffledIndices, rng);
+		Partition(numFolds);
+	}
+
+	inline FoldPlan::FoldPlan(std::vector<size_t> const& shuffledIndices,
+		size_t const numFolds) :
+		ShuffledIndices(shuffledIndices),
+		Stream(SerializeOrdering(shuffledIndices))
+	{
+		Partition(numFolds);
+	}
+
+	inline void FoldPlan::Partition(size_t const numFolds)
+	{
+		size_t const numExamples = ShuffledIndices.size();
+		DLIB_ASSERT(numFolds > 0 && numFolds < numExamples,
+			"Input parameter numFolds must be greater than zero and less than the provided number of examples.");
+
+		TrainIndices.resize(numFolds);
+		TestIndices.resize(numFolds);
+		size_t const chunks = numExamples / numFolds;
+		for (size_t fold = 0; fold < numFolds; ++fold)
+		{
+			size_t const testStartIndex = fold * chunks;
+			size_t const testEndIndex = (fold + 1) * chunks;
+
+			TestIndices[fold].assign(ShuffledIndices.begin() + testStartIndex, ShuffledIndices.begin() + testEndIndex);
+
+			TrainIndices[fold].reserve(numExamples - (testEndIndex - testStartIndex));
+			TrainIndices[fold].insert(TrainIndices[fold].end(), ShuffledIndices.begin(), ShuffledIndices.begin() + testStartIndex);
+			TrainIndices[fold].insert(TrainIndices[fold].end(), ShuffledIndices.begin() + testEndIndex, ShuffledIndices.end());
+		}
+	}
+
+	inline size_t FoldPlan::GetNumExamples() const
+	{
+		return ShuffledIndices.size();
+	}
+
+	inline size_t FoldPlan::GetNumFolds() const
+	{
+		return TestIndices.size();
+	}
+
+	inline std::vector<size_t> const& FoldPlan::GetShuffledIndices() const
+	{
+		return ShuffledIndices;
+	}
+
+	inline std::vector<size_t> const& FoldPlan::GetTrainIndices(size_t const fold) const
+	{
+		DLIB_ASSERT(fold < TrainIndices.size(),
+			"Fold index out of range.");
+		return TrainIndices[fold];
+	}
+
+	inline std::vector<size_t> const& FoldPlan::GetTestIndices(size_t const fold) const
+	{
+		DLIB_ASSERT(fold < TestIndices.size(),
+			"Fold index out of range.");
+		return TestIndices[fold];
+	}
+
+	inline RandomStream const& FoldPlan::GetRandomStream() const
+	{
+		return Stream;
+	}
+
+	inline std::string FoldPlan::SerializeOrdering(std::vector<size_t> const& shuffledIndices)
+	{
+		std::ostringstream out;
+		dlib::serialize(shuffledIndices, out);
+		return out.str();
+	}
+}
@@ -135,8 +135,10 @@ namespace Regressors
         const in_sample_vector_type& x_,
         const in_scalar_vector_type& y_) const
     {
-        auto x = dlib::mat(x_);
-        auto y = dlib::mat(y_);
+        // unqualified so that views over the examples resolve to their own mat() overload
+        using dlib::mat;
+        auto x = mat(x_);
+        auto y = mat(y_);
         // make sure requires clause is not broken
         DLIB_ASSERT(dlib::is_learning_problem(x, y),
             "\t GKMTrainer::Train(x,y)"
@@ -0,0 +1,57 @@
+#pragma once
+
+namespace Regressors
+{
+	template <typename ValueType>
+	IndexedVectorView<ValueType>::IndexedVectorView(std::vector<ValueType> const& source,
+		std::vector<size_t> const& indices) :
+		Source(&source),
+		Indices(&indices)
+	{
+	}
+
+	template <typename ValueType>
+	size_t IndexedVectorView<ValueType>::size() const
+	{
+		return Indices->size();
+	}
+
+	template <typename ValueType>
+	ValueType const& IndexedVectorView<ValueType>::operator[](size_t const index) const
+	{
+		DLIB_ASSERT(index < Indices->size() && (*Indices)[index] < Source->size(),
+			"IndexedVectorView access out of bounds.");
+		return (*Source)[(*Indices)[index]];
+	}
+
+	template <typename ValueType>
+	std::vector<ValueType> IndexedVectorView<ValueType>::Materialise() const
+	{
+		std::vector<ValueType> result;
+		result.reserve(size());
+		for (auto const index : *Indices)
+		{
+			result.emplace_back((*Source)[index]);
+		}
+		return result;
+	}
+
+	template <typename ValueType>
+	dlib::matrix_op<op_indexed_vector_to_mat<ValueType>> const mat(IndexedVectorView<ValueType> const& view)
+	{
+		typedef op_indexed_vector_to_mat<ValueType> op;
+		return dlib::matrix_op<op>(op(view));
+	}
+
+	template <typename ValueType>
+	std::vector<ValueType> const& AsStdVector(std::vector<ValueType> const& examples)
+	{
+		return examples;
+	}
+
+	template <typename ValueType>
+	std::vector<ValueType> AsStdVector(IndexedVectorView<ValueType> const& examples)
+	{
+		return examples.Materialise();
+	}
+}
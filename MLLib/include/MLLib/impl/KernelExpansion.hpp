@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+
+namespace Regressors
+{
+	template <class KernelType>
+	long const KernelExpansion<KernelType>::BlockSize = 8;
+
+	template <class KernelType>
+	KernelExpansion<KernelType>::KernelExpansion() :
+		Bias(0)
+	{
+	}
+
+	template <class KernelType>
+	KernelExpansion<KernelType>::KernelExpansion(DecisionFunction const& function) :
+		Kernel(function.kernel_function),
+		Alpha(function.alpha),
+		Bias(function.b)
+	{
+		long const numBasisVectors = function.basis_vectors.size();
+		long const numOrdinates = numBasisVectors > 0 ? function.basis_vectors(0).size() : 0;
+		BasisVectors.set_size(numBasisVectors, numOrdinates);
+		for (long i = 0; i < numBasisVectors; ++i)
+		{
+			for (long k = 0; k < numOrdinates; ++k)
+			{
+				BasisVectors(i, k) = function.basis_vectors(i)(k);
+			}
+		}
+	}
+
+	template <class KernelType>
+	typename KernelExpansion<KernelType>::T KernelExpansion<KernelType>::operator()(SampleType const& input) const
+	{
+		DLIB_ASSERT(input.size() == BasisVectors.nc(),
+			"Input has the wrong number of ordinates.");
+
+		T result = 0;
+		T kernelValues[TransformBlockSize];
+		for (long blockBegin = 0; blockBegin < BasisVectors.nr(); blockBegin += TransformBlockSize)
+		{
+			long const numBlockBasisVectors = std::min(TransformBlockSize, BasisVectors.nr() - blockBegin);
+			for (long b = 0; b < numBlockBasisVectors; ++b)
+			{
+				T const* const basisVector = &BasisVectors(blockBegin + b, 0);
+				T pairValue = 0;
+				for (long k = 0; k < BasisVectors.nc(); ++k)
+				{
+					pairValue += PairTerm(basisVector[k], input(k));
+				}
+				kernelValues[b] = pairValue;
+			}
+
+			TransformPairValues(kernelValues, numBlockBasisVectors);
+			for (long b = 0; b < numBlockBasisVectors; ++b)
+			{
+				result += Alpha(blockBegin + b) * kernelValues[b];
+			}
+		}
+		return result - Bias;
+	}
+
+	template <class KernelType>
+	void KernelExpansion<KernelType>::Evaluate(dlib::matrix<T> const& inputs, long const numInputs, T* outputs, dlib::matrix<T>& kernelValues) const
+	{
+		DLIB_ASSERT(inputs.nc() == BasisVectors.nc() && numInputs <= inputs.nr(),
+			"Inputs have the wrong number of ordinates.");
+
+		long const numBasisVectors = BasisVectors.nr();
+		long const numOrdinates = BasisVectors.nc();
+		kernelValues.set_size(inputs.nr(), numBasisVectors);
+
+		// the dot products or squared distances of each block of inputs with every basis vector, each summed over the
+		// ordinates in order, so that every kernel value matches the single-input evaluation
+		for (long blockBegin = 0; blockBegin < numInputs; blockBegin += BlockSize)
+		{
+			long const blockEnd = std::min(blockBegin + BlockSize, numInputs);
+			for (long i = 0; i < numBasisVectors; ++i)
+			{
+				T const* const basisVector = &BasisVectors(i, 0);
+				for (long j = blockBegin; j < blockEnd; ++j)
+				{
+					T const* const input = &inputs(j, 0);
+					T pairValue = 0;
+					for (long k = 0; k < numOrdinates; ++k)
+					{
+						pairValue += PairTerm(basisVector[k], input[k]);
+					}
+					kernelValues(j, i) = pairValue;
+				}
+			}
+		}
+
+		for (long j = 0; j < numInputs; ++j)
+		{
+			T result = 0;
+			if (numBasisVectors > 0)
+			{
+				T* const inputKernelValues = &kernelValues(j, 0);
+				TransformPairValues(inputKernelValues, numBasisVectors);
+				for (long i = 0; i < numBasisVectors; ++i)
+				{
+					result += Alpha(i) * inputKernelValues[i];
+				}
+			}
+			outputs[j] = result - Bias;
+		}
+	}
+
+	template <class KernelType>
+	typename KernelExpansion<KernelType>::T KernelExpansion<KernelType>::PairTerm(T const basisOrdinate, T const inputOrdinate)
+	{
+		if constexpr (KernelType::IsDistanceKernel)
+		{
+			T const difference = basisOrdinate - inputOrdinate;
+			return difference * difference;
+		}
+		else
+		{
+			return basisOrdinate * inputOrdinate;
+		}
+	}
+
+	template <class KernelType>
+	void KernelExpansion<KernelType>::TransformPairValues(T* values, long const numValues) const
+	{
+		if constexpr (KernelType::IsDistanceKernel)
+		{
+			KernelType::FromSquaredDistances(Kernel, values, static_cast<size_t>(numValues));
+		}
+		else
+		{
+			KernelType::FromDotProducts(Kernel, values, static_cast<size_t>(numValues));
+		}
+	}
+
+	template <class KernelType>
+	long KernelExpansion<KernelType>::GetNumBasisVectors() const
+	{
+		return BasisVectors.nr();
+	}
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 
 namespace Regressors
 {
@@ -26,6 +28,18 @@ namespace Regressors
 			return KernelFunctionType();
 		}
 
+		template <typename SampleType>
+		void LinearKernel<SampleType>::FromDotProducts(KernelFunctionType const& kernel, T* values, size_t const numValues)
+		{
+			// the dot products are already the kernel values
+		}
+
+		template <typename SampleType>
+		static void LinearKernel<SampleType>::AppendKernelParamsAxes(CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+		}
+
 		template <typename SampleType> template <class RegressionType>
 		static void LinearKernel<SampleType>::IterateKernelParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 			CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -40,14 +54,14 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void LinearKernel<SampleType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 			size_t const mapOffset)
 		{
 		}
@@ -55,7 +69,7 @@ namespace Regressors
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void LinearKernel<SampleType>::UnpackParameters(OneShotTrainingParams& osTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
@@ -84,6 +98,7 @@ namespace Regressors
 			OneShotTrainingParams temp;
 			LowerGamma = temp.Gamma;
 			UpperGamma = temp.Gamma;
+			GammaScale = EParameterScale::Linear;
 			LowerCoeff = temp.Coeff;
 			UpperCoeff = temp.Coeff;
 			LowerDegree = temp.Degree;
@@ -96,6 +111,24 @@ namespace Regressors
 			return KernelFunctionType(osTrainingParams.Gamma, osTrainingParams.Coeff, osTrainingParams.Degree);
 		}
 
+		template <typename SampleType>
+		void PolynomialKernel<SampleType>::FromDotProducts(KernelFunctionType const& kernel, T* values, size_t const numValues)
+		{
+			for (size_t i = 0; i < numValues; ++i)
+			{
+				values[i] = std::pow(kernel.gamma * values[i] + kernel.coef, kernel.degree);
+			}
+		}
+
+		template <typename SampleType>
+		static void PolynomialKernel<SampleType>::AppendKernelParamsAxes(CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(kernelCrossValidationTrainingParams.GammaToTry.size());
+			numValuesPerAxis.push_back(kernelCrossValidationTrainingParams.CoeffToTry.size());
+			numValuesPerAxis.push_back(kernelCrossValidationTrainingParams.DegreeToTry.size());
+		}
+
 		template <typename SampleType> template <class RegressionType>
 		static void PolynomialKernel<SampleType>::IterateKernelParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 			CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -124,24 +157,24 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerGamma;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperGamma;
 				isIntegerParam[paramsOffset] = false;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[mapOffset + 1].first)
+			if (optimiseParamsMap[mapOffset + 1].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerCoeff;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperCoeff;
 				isIntegerParam[paramsOffset] = false;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[mapOffset + 2].first)
+			if (optimiseParamsMap[mapOffset + 2].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerDegree;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperDegree;
@@ -152,50 +185,51 @@ namespace Regressors
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void PolynomialKernel<SampleType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 			size_t const mapOffset)
 		{
-			optimiseParamsMap[mapOffset].first = fmgTrainingParams.LowerGamma != fmgTrainingParams.UpperGamma;
-			optimiseParamsMap[mapOffset].second = fmgTrainingParams.LowerGamma;
-			optimiseParamsMap[mapOffset + 1].first = fmgTrainingParams.LowerCoeff != fmgTrainingParams.UpperCoeff;
-			optimiseParamsMap[mapOffset + 1].second = fmgTrainingParams.LowerCoeff;
-			optimiseParamsMap[mapOffset + 2].first = fmgTrainingParams.LowerDegree != fmgTrainingParams.UpperDegree;
-			optimiseParamsMap[mapOffset + 2].second = fmgTrainingParams.LowerDegree;
+			optimiseParamsMap[mapOffset].Optimise = fmgTrainingParams.LowerGamma != fmgTrainingParams.UpperGamma;
+			optimiseParamsMap[mapOffset].FixedValue = fmgTrainingParams.LowerGamma;
+			optimiseParamsMap[mapOffset].Scale = fmgTrainingParams.GammaScale;
+			optimiseParamsMap[mapOffset + 1].Optimise = fmgTrainingParams.LowerCoeff != fmgTrainingParams.UpperCoeff;
+			optimiseParamsMap[mapOffset + 1].FixedValue = fmgTrainingParams.LowerCoeff;
+			optimiseParamsMap[mapOffset + 2].Optimise = fmgTrainingParams.LowerDegree != fmgTrainingParams.UpperDegree;
+			optimiseParamsMap[mapOffset + 2].FixedValue = fmgTrainingParams.LowerDegree;
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void PolynomialKernel<SampleType>::UnpackParameters(OneShotTrainingParams& osTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				osTrainingParams.Gamma = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.Gamma = optimiseParamsMap[mapOffset].second;
+				osTrainingParams.Gamma = optimiseParamsMap[mapOffset].FixedValue;
 			}
-			if (optimiseParamsMap[mapOffset + 1].first)
+			if (optimiseParamsMap[mapOffset + 1].Optimise)
 			{
 				osTrainingParams.Coeff = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.Coeff = optimiseParamsMap[mapOffset + 1].second;
+				osTrainingParams.Coeff = optimiseParamsMap[mapOffset + 1].FixedValue;
 			}
-			if (optimiseParamsMap[mapOffset + 2].first)
+			if (optimiseParamsMap[mapOffset + 2].Optimise)
 			{
 				osTrainingParams.Degree = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.Degree = optimiseParamsMap[mapOffset + 2].second;
+				osTrainingParams.Degree = optimiseParamsMap[mapOffset + 2].FixedValue;
 			}
 		}
 
@@ -220,6 +254,7 @@ namespace Regressors
 			OneShotTrainingParams temp;
 			LowerGamma = temp.Gamma;
 			UpperGamma = temp.Gamma;
+			GammaScale = EParameterScale::Linear;
 		}
 
 		template <typename SampleType>
@@ -228,6 +263,23 @@ namespace Regressors
 			return KernelFunctionType(osTrainingParams.Gamma);
 		}
 
+		template <typename SampleType>
+		void RadialBasisKernel<SampleType>::FromSquaredDistances(KernelFunctionType const& kernel, T* values, size_t const numValues)
+		{
+			for (size_t i = 0; i < numValues; ++i)
+			{
+				values[i] = -kernel.gamma * values[i];
+			}
+			VectorMath::Exp(values, numValues);
+		}
+
+		template <typename SampleType>
+		static void RadialBasisKernel<SampleType>::AppendKernelParamsAxes(CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(kernelCrossValidationTrainingParams.GammaToTry.size());
+		}
+
 		template <typename SampleType> template <class RegressionType>
 		static void RadialBasisKernel<SampleType>::IterateKernelParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 			CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -248,10 +300,10 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerGamma;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperGamma;
@@ -262,28 +314,29 @@ namespace Regressors
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void RadialBasisKernel<SampleType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 			size_t const mapOffset)
 		{
-			optimiseParamsMap[mapOffset].first = fmgTrainingParams.LowerGamma != fmgTrainingParams.UpperGamma;
-			optimiseParamsMap[mapOffset].second = fmgTrainingParams.LowerGamma;
+			optimiseParamsMap[mapOffset].Optimise = fmgTrainingParams.LowerGamma != fmgTrainingParams.UpperGamma;
+			optimiseParamsMap[mapOffset].FixedValue = fmgTrainingParams.LowerGamma;
+			optimiseParamsMap[mapOffset].Scale = fmgTrainingParams.GammaScale;
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void RadialBasisKernel<SampleType>::UnpackParameters(OneShotTrainingParams& osTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				osTrainingParams.Gamma = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.Gamma = optimiseParamsMap[mapOffset].second;
+				osTrainingParams.Gamma = optimiseParamsMap[mapOffset].FixedValue;
 			}
 		}
 
@@ -309,6 +362,7 @@ namespace Regressors
 			OneShotTrainingParams temp;
 			LowerGamma = temp.Gamma;
 			UpperGamma = temp.Gamma;
+			GammaScale = EParameterScale::Linear;
 			LowerCoeff = temp.Coeff;
 			UpperCoeff = temp.Coeff;
 		}
@@ -319,6 +373,24 @@ namespace Regressors
 			return KernelFunctionType(osTrainingParams.Gamma, osTrainingParams.Coeff);
 		}
 
+		template <typename SampleType>
+		void SigmoidKernel<SampleType>::FromDotProducts(KernelFunctionType const& kernel, T* values, size_t const numValues)
+		{
+			for (size_t i = 0; i < numValues; ++i)
+			{
+				values[i] = kernel.gamma * values[i] + kernel.coef;
+			}
+			VectorMath::Tanh(values, numValues);
+		}
+
+		template <typename SampleType>
+		static void SigmoidKernel<SampleType>::AppendKernelParamsAxes(CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(kernelCrossValidationTrainingParams.GammaToTry.size());
+			numValuesPerAxis.push_back(kernelCrossValidationTrainingParams.CoeffToTry.size());
+		}
+
 		template <typename SampleType> template <class RegressionType>
 		static void SigmoidKernel<SampleType>::IterateKernelParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 			CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
@@ -343,17 +415,17 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerGamma;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperGamma;
 				isIntegerParam[paramsOffset] = false;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[mapOffset + 1].first)
+			if (optimiseParamsMap[mapOffset + 1].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerCoeff;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperCoeff;
@@ -364,39 +436,40 @@ namespace Regressors
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void SigmoidKernel<SampleType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 			size_t const mapOffset)
 		{
-			optimiseParamsMap[mapOffset].first = fmgTrainingParams.LowerGamma != fmgTrainingParams.UpperGamma;
-			optimiseParamsMap[mapOffset].second = fmgTrainingParams.LowerGamma;
-			optimiseParamsMap[mapOffset + 1].first = fmgTrainingParams.LowerCoeff != fmgTrainingParams.UpperCoeff;
-			optimiseParamsMap[mapOffset + 1].second = fmgTrainingParams.LowerCoeff;
+			optimiseParamsMap[mapOffset].Optimise = fmgTrainingParams.LowerGamma != fmgTrainingParams.UpperGamma;
+			optimiseParamsMap[mapOffset].FixedValue = fmgTrainingParams.LowerGamma;
+			optimiseParamsMap[mapOffset].Scale = fmgTrainingParams.GammaScale;
+			optimiseParamsMap[mapOffset + 1].Optimise = fmgTrainingParams.LowerCoeff != fmgTrainingParams.UpperCoeff;
+			optimiseParamsMap[mapOffset + 1].FixedValue = fmgTrainingParams.LowerCoeff;
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void SigmoidKernel<SampleType>::UnpackParameters(OneShotTrainingParams& osTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				osTrainingParams.Gamma = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.Gamma = optimiseParamsMap[mapOffset].second;
+				osTrainingParams.Gamma = optimiseParamsMap[mapOffset].FixedValue;
 			}
-			if (optimiseParamsMap[mapOffset + 1].first)
+			if (optimiseParamsMap[mapOffset + 1].Optimise)
 			{
 				osTrainingParams.Coeff = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.Coeff = optimiseParamsMap[mapOffset + 1].second;
+				osTrainingParams.Coeff = optimiseParamsMap[mapOffset + 1].FixedValue;
 			}
 		}
 
@@ -424,6 +497,12 @@ namespace Regressors
 			return ExtractorFunctionType();
 		}
 
+		template <typename SampleType>
+		static void DenseExtractor<SampleType>::AppendExtractorParamsAxes(CrossValidationTrainingParams const& extractorCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+		}
+
 		template <typename SampleType> template <class RegressionType>
 		static void DenseExtractor<SampleType>::IterateExtractorParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
 			CrossValidationTrainingParams const& extractorCrossValidationTrainingParams,
@@ -438,14 +517,14 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void DenseExtractor<SampleType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 			size_t const mapOffset)
 		{
 		}
@@ -453,7 +532,7 @@ namespace Regressors
 		template <typename SampleType> template <size_t TotalNumParams>
 		static void DenseExtractor<SampleType>::UnpackParameters(OneShotTrainingParams& osTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
@@ -34,6 +34,14 @@ namespace Regressors
 			return 1.0 / (1.0 + std::exp(-input));
 		}
 
+		template <typename KernelType>
+		static void LogitLinkFunction<KernelType>::AppendLinkFunctionParamsAxes(CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
+			typename KernelType::CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			KernelType::AppendKernelParamsAxes(kernelCrossValidationTrainingParams, numValuesPerAxis);
+		}
+
 		template <typename KernelType>
 		template <class RegressionType>
 		static void LogitLinkFunction<KernelType>::IterateLinkFunctionParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
@@ -51,7 +59,7 @@ namespace Regressors
 			col_vector<ScalarType>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
 		}
@@ -59,7 +67,7 @@ namespace Regressors
 		template <typename KernelType>
 		template <size_t TotalNumParams>
 		static void LogitLinkFunction<KernelType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams>& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams>& optimiseParamsMap,
 			size_t const mapOffset)
 		{
 		}
@@ -68,7 +76,7 @@ namespace Regressors
 		template <size_t TotalNumParams>
 		static void LogitLinkFunction<KernelType>::UnpackParameters(OneShotTrainingParams& osTrainingParams,
 			col_vector<ScalarType> const& vecParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
@@ -169,6 +177,15 @@ namespace Regressors
 			return ret;
 		}
 
+		template <typename KernelType>
+		static void FourierLinkFunction<KernelType>::AppendLinkFunctionParamsAxes(CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
+			typename KernelType::CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(linkFunctionCrossValidationTrainingParams.NumTermsToTry.size());
+			KernelType::AppendKernelParamsAxes(kernelCrossValidationTrainingParams, numValuesPerAxis);
+		}
+
 		template <typename KernelType>
 		template <class RegressionType>
 		static void FourierLinkFunction<KernelType>::IterateLinkFunctionParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
@@ -190,10 +207,10 @@ namespace Regressors
 			col_vector<ScalarType>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerNumTerms;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperNumTerms;
@@ -205,29 +222,29 @@ namespace Regressors
 		template <typename KernelType>
 		template <size_t TotalNumParams>
 		static void FourierLinkFunction<KernelType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams>& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams>& optimiseParamsMap,
 			size_t const mapOffset)
 		{
-			optimiseParamsMap[mapOffset].first = fmgTrainingParams.LowerNumTerms != fmgTrainingParams.UpperNumTerms;
-			optimiseParamsMap[mapOffset].second = fmgTrainingParams.LowerNumTerms;
+			optimiseParamsMap[mapOffset].Optimise = fmgTrainingParams.LowerNumTerms != fmgTrainingParams.UpperNumTerms;
+			optimiseParamsMap[mapOffset].FixedValue = fmgTrainingParams.LowerNumTerms;
 		}
 
 		template <typename KernelType>
 		template <size_t TotalNumParams>
 		static void FourierLinkFunction<KernelType>::UnpackParameters(OneShotTrainingParams& osTrainingParams,
 			col_vector<ScalarType> const& vecParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				osTrainingParams.NumTerms = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.NumTerms = optimiseParamsMap[mapOffset].second;
+				osTrainingParams.NumTerms = optimiseParamsMap[mapOffset].FixedValue;
 			}
 		}
 
@@ -289,6 +306,14 @@ namespace Regressors
 			return numerator / denominator;
 		}
 
+		template <typename KernelType>
+		static void LagrangeLinkFunction<KernelType>::AppendLinkFunctionParamsAxes(CrossValidationTrainingParams const& linkFunctionCrossValidationTrainingParams,
+			typename KernelType::CrossValidationTrainingParams const& kernelCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			KernelType::AppendKernelParamsAxes(kernelCrossValidationTrainingParams, numValuesPerAxis);
+		}
+
 		template <typename KernelType>
 		template <class RegressionType>
 		static void LagrangeLinkFunction<KernelType>::IterateLinkFunctionParams(typename RegressionType::OneShotTrainingParams& regressionOneShotTrainingParams,
@@ -306,7 +331,7 @@ namespace Regressors
 			col_vector<ScalarType>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
 		}
@@ -314,7 +339,7 @@ namespace Regressors
 		template <typename KernelType>
 		template <size_t TotalNumParams>
 		static void LagrangeLinkFunction<KernelType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams>& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams>& optimiseParamsMap,
 			size_t const mapOffset)
 		{
 		}
@@ -323,7 +348,7 @@ namespace Regressors
 		template <size_t TotalNumParams>
 		static void LagrangeLinkFunction<KernelType>::UnpackParameters(OneShotTrainingParams& osTrainingParams,
 			col_vector<ScalarType> const& vecParams,
-			std::array<std::pair<bool, ScalarType>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<ScalarType>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
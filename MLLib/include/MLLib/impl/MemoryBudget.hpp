@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+
+namespace Regressors
+{
+	inline MemoryBudget::MemoryBudget(size_t const numBytes) :
+		NumBytes(numBytes),
+		NumBytesInUse(0),
+		PeakNumBytesInUse(0)
+	{
+	}
+
+	inline void MemoryBudget::Acquire(size_t const numBytes)
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		Released.wait(lock, [this, numBytes]()
+			{
+				return NumBytesInUse == 0 || NumBytesInUse + numBytes <= NumBytes;
+			});
+		NumBytesInUse += numBytes;
+		PeakNumBytesInUse = std::max(PeakNumBytesInUse, NumBytesInUse);
+	}
+
+	inline void MemoryBudget::Release(size_t const numBytes)
+	{
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			DLIB_ASSERT(numBytes <= NumBytesInUse,
+				"Released more memory than was acquired.");
+			NumBytesInUse -= numBytes;
+		}
+		Released.notify_all();
+	}
+
+	inline size_t MemoryBudget::GetNumBytes() const
+	{
+		return NumBytes;
+	}
+
+	inline size_t MemoryBudget::GetNumBytesInUse() const
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		return NumBytesInUse;
+	}
+
+	inline size_t MemoryBudget::GetPeakNumBytesInUse() const
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		return PeakNumBytesInUse;
+	}
+
+	inline MemoryAdmission::MemoryAdmission(MemoryBudget* const budget,
+		size_t const numBytes) :
+		Budget(budget),
+		NumBytes(numBytes)
+	{
+		if (Budget != nullptr)
+		{
+			Budget->Acquire(NumBytes);
+		}
+	}
+
+	inline MemoryAdmission::~MemoryAdmission()
+	{
+		if (Budget != nullptr)
+		{
+			Budget->Release(NumBytes);
+		}
+	}
+}
@@ -39,6 +39,46 @@ namespace Regressors
 			input = Normaliser(input);
 		}
 
+		template <typename SampleType>
+		void NormaliserModifier<SampleType>::ModifierFunction::operator()(SampleType const& input, SampleType& output) const
+		{
+			// the same arithmetic as dlib::vector_normalizer, which holds the reciprocal standard deviations, without its
+			// shared result buffer, so concurrent predictions neither allocate nor race on it
+			typename dlib::vector_normalizer<SampleType>::matrix_type const& means = Normaliser.means();
+			typename dlib::vector_normalizer<SampleType>::matrix_type const& reciprocalStdDevs = Normaliser.std_devs();
+			output.set_size(input.size());
+			for (long i = 0; i < input.size(); ++i)
+			{
+				output(i) = (input(i) - means(i)) * reciprocalStdDevs(i);
+			}
+		}
+
+		template <typename SampleType>
+		void NormaliserModifier<SampleType>::ModifierFunction::GetAffineTransform(long const numInputs, dlib::matrix<T>& matrix, col_vector<T>& offset) const
+		{
+			typename dlib::vector_normalizer<SampleType>::matrix_type const& means = Normaliser.means();
+			typename dlib::vector_normalizer<SampleType>::matrix_type const& reciprocalStdDevs = Normaliser.std_devs();
+			matrix = dlib::zeros_matrix<T>(numInputs, numInputs);
+			offset.set_size(numInputs);
+			for (long i = 0; i < numInputs; ++i)
+			{
+				matrix(i, i) = reciprocalStdDevs(i);
+				offset(i) = -means(i) * reciprocalStdDevs(i);
+			}
+		}
+
+		template <typename SampleType>
+		long NormaliserModifier<SampleType>::ModifierFunction::GetNumInputs() const
+		{
+			return Normaliser.means().size();
+		}
+
+		template <typename SampleType>
+		void NormaliserModifier<SampleType>::AppendModifierParamsAxes(CrossValidationTrainingParams const& modifierCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+		}
+
 		template <typename SampleType> template <size_t I, class... ModifierCrossValidationTrainingTypes>
 		void NormaliserModifier<SampleType>::IterateModifierParams(std::tuple<ModifierCrossValidationTrainingTypes...> const& modifierCrossValidationParams,
 			std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>& modifierOneShotTrainingParamsToTry,
@@ -57,7 +97,7 @@ namespace Regressors
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
-		void NormaliserModifier<SampleType>::ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& params)
+		void NormaliserModifier<SampleType>::ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& params)
 		{
 
 		}
@@ -66,7 +106,7 @@ namespace Regressors
 		void NormaliserModifier<SampleType>::PackageParameters(col_vector<T>& lowerParams,
 			col_vector<T>& upperParams,
 			std::vector<bool>& isIntegerParam,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset,
 			FindMinGlobalTrainingParams const& fmgTrainingParams)
@@ -76,7 +116,7 @@ namespace Regressors
 		template <typename SampleType> template <size_t I, size_t TotalNumParams, class... ModifierOneShotTrainingParams>
 		void NormaliserModifier<SampleType>::UnpackParameters(std::tuple<ModifierOneShotTrainingParams...>& modifierOneShotTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
@@ -122,6 +162,7 @@ namespace Regressors
 			OneShotTrainingParams temp;
 			LowerTargetVariance = temp.TargetVariance;
 			UpperTargetVariance = temp.TargetVariance;
+			TargetVarianceScale = EParameterScale::Linear;
 		}
 
 		template <typename SampleType>
@@ -137,6 +178,33 @@ namespace Regressors
 			input = PCAModel.Encode(input, PCAModel.nParams());;
 		}
 
+		template <typename SampleType>
+		void InputPCAModifier<SampleType>::ModifierFunction::operator()(SampleType const& input, SampleType& output) const
+		{
+			PCAModel.Encode(input, PCAModel.nParams(), output);
+		}
+
+		template <typename SampleType>
+		void InputPCAModifier<SampleType>::ModifierFunction::GetAffineTransform(long const numInputs, dlib::matrix<T>& matrix, col_vector<T>& offset) const
+		{
+			DLIB_ASSERT(numInputs == static_cast<long>(PCAModel.nVariables()),
+				"PCA modifier applied to inputs of the wrong size.");
+			PCAModel.GetAffineTransform(PCAModel.nParams(), matrix, offset);
+		}
+
+		template <typename SampleType>
+		long InputPCAModifier<SampleType>::ModifierFunction::GetNumInputs() const
+		{
+			return static_cast<long>(PCAModel.nVariables());
+		}
+
+		template <typename SampleType>
+		void InputPCAModifier<SampleType>::AppendModifierParamsAxes(CrossValidationTrainingParams const& modifierCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(modifierCrossValidationTrainingParams.TargetVarianceToTry.size());
+		}
+
 		template <typename SampleType> template <size_t I, class... ModifierCrossValidationTrainingTypes>
 		void InputPCAModifier<SampleType>::IterateModifierParams(std::tuple<ModifierCrossValidationTrainingTypes...> const& modifierCrossValidationParams,
 			std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>& modifierOneShotTrainingParamsToTry,
@@ -160,22 +228,23 @@ namespace Regressors
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
-		void InputPCAModifier<SampleType>::ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& params)
+		void InputPCAModifier<SampleType>::ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& params)
 		{
-			optimiseParamsMap[offset].first = params.LowerTargetVariance != params.UpperTargetVariance;
-			optimiseParamsMap[offset].second = params.LowerTargetVariance;
+			optimiseParamsMap[offset].Optimise = params.LowerTargetVariance != params.UpperTargetVariance;
+			optimiseParamsMap[offset].FixedValue = params.LowerTargetVariance;
+			optimiseParamsMap[offset].Scale = params.TargetVarianceScale;
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		void InputPCAModifier<SampleType>::PackageParameters(col_vector<T>& lowerParams,
 			col_vector<T>& upperParams,
 			std::vector<bool>& isIntegerParam,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset,
 			FindMinGlobalTrainingParams const& fmgTrainingParams)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				lowerParams(paramsOffset) = fmgTrainingParams.LowerTargetVariance;
 				upperParams(paramsOffset) = fmgTrainingParams.UpperTargetVariance;
@@ -187,19 +256,19 @@ namespace Regressors
 		template <typename SampleType> template <size_t I, size_t TotalNumParams, class... ModifierOneShotTrainingParams>
 		void InputPCAModifier<SampleType>::UnpackParameters(std::tuple<ModifierOneShotTrainingParams...>& modifierOneShotTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
 			auto& osTrainingParams = std::get<I>(modifierOneShotTrainingParams);
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				osTrainingParams.TargetVariance = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.TargetVariance = optimiseParamsMap[mapOffset].second;
+				osTrainingParams.TargetVariance = optimiseParamsMap[mapOffset].FixedValue;
 			}
 			if constexpr (sizeof...(ModifierOneShotTrainingParams) == I + 1)
 			{
@@ -271,6 +340,7 @@ namespace Regressors
 			OneShotTrainingParams temp;
 			LowerFeatureFraction = temp.FeatureFraction;
 			UpperFeatureFraction = temp.FeatureFraction;
+			FeatureFractionScale = EParameterScale::Linear;
 		}
 
 		template <typename SampleType>
@@ -291,6 +361,41 @@ namespace Regressors
 			input = featureSelectedInput;
 		}
 
+		template <typename SampleType>
+		void FeatureSelectionModifier<SampleType>::ModifierFunction::operator()(SampleType const& input, SampleType& output) const
+		{
+			output.set_size(FeatureIndices.size());
+			for (unsigned i = 0; i < FeatureIndices.size(); ++i)
+			{
+				output(i) = input(FeatureIndices[i]);
+			}
+		}
+
+		template <typename SampleType>
+		void FeatureSelectionModifier<SampleType>::ModifierFunction::GetAffineTransform(long const numInputs, dlib::matrix<T>& matrix, col_vector<T>& offset) const
+		{
+			matrix = dlib::zeros_matrix<T>(static_cast<long>(FeatureIndices.size()), numInputs);
+			offset = dlib::zeros_matrix<T>(static_cast<long>(FeatureIndices.size()), 1);
+			for (unsigned i = 0; i < FeatureIndices.size(); ++i)
+			{
+				matrix(i, FeatureIndices[i]) = 1;
+			}
+		}
+
+		template <typename SampleType>
+		long FeatureSelectionModifier<SampleType>::ModifierFunction::GetNumInputs() const
+		{
+			// only the selected ordinates are known, not how many the inputs have
+			return 0;
+		}
+
+		template <typename SampleType>
+		void FeatureSelectionModifier<SampleType>::AppendModifierParamsAxes(CrossValidationTrainingParams const& modifierCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(modifierCrossValidationTrainingParams.FeatureFractionsToTry.size());
+		}
+
 		template <typename SampleType> template <size_t I, class... ModifierCrossValidationTrainingTypes>
 		void FeatureSelectionModifier<SampleType>::IterateModifierParams(std::tuple<ModifierCrossValidationTrainingTypes...> const& modifierCrossValidationParams,
 			std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>& modifierOneShotTrainingParamsToTry,
@@ -314,22 +419,23 @@ namespace Regressors
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
-		void FeatureSelectionModifier<SampleType>::ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& fmgParams)
+		void FeatureSelectionModifier<SampleType>::ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap, size_t const offset, FindMinGlobalTrainingParams const& fmgParams)
 		{
-			optimiseParamsMap[offset].first = fmgParams.LowerFeatureFraction != fmgParams.UpperFeatureFraction;
-			optimiseParamsMap[offset].second = fmgParams.LowerFeatureFraction;
+			optimiseParamsMap[offset].Optimise = fmgParams.LowerFeatureFraction != fmgParams.UpperFeatureFraction;
+			optimiseParamsMap[offset].FixedValue = fmgParams.LowerFeatureFraction;
+			optimiseParamsMap[offset].Scale = fmgParams.FeatureFractionScale;
 		}
 
 		template <typename SampleType> template <size_t TotalNumParams>
 		void FeatureSelectionModifier<SampleType>::PackageParameters(col_vector<T>& lowerParams,
 			col_vector<T>& upperParams,
 			std::vector<bool>& isIntegerParam,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset,
 			FindMinGlobalTrainingParams const& fmgTrainingParams)
 		{
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				lowerParams(paramsOffset) = fmgTrainingParams.LowerFeatureFraction;
 				upperParams(paramsOffset) = fmgTrainingParams.UpperFeatureFraction;
@@ -341,19 +447,19 @@ namespace Regressors
 		template <typename SampleType> template <size_t I, size_t TotalNumParams, class... ModifierOneShotTrainingParams>
 		void FeatureSelectionModifier<SampleType>::UnpackParameters(std::tuple<ModifierOneShotTrainingParams...>& modifierOneShotTrainingParams,
 			col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t const mapOffset,
 			size_t& paramsOffset)
 		{
 			auto& osTrainingParams = std::get<I>(modifierOneShotTrainingParams);
-			if (optimiseParamsMap[mapOffset].first)
+			if (optimiseParamsMap[mapOffset].Optimise)
 			{
 				osTrainingParams.FeatureFraction = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				osTrainingParams.FeatureFraction = optimiseParamsMap[mapOffset].second;
+				osTrainingParams.FeatureFraction = optimiseParamsMap[mapOffset].FixedValue;
 			}
 			if constexpr (sizeof...(ModifierOneShotTrainingParams) == I + 1)
 			{
@@ -0,0 +1,45 @@
+#pragma once
+#include <cmath>
+
+namespace Regressors
+{
+	template <typename T>
+	ParameterMapping<T>::ParameterMapping() :
+		Optimise(false),
+		FixedValue(0),
+		Scale(EParameterScale::Linear)
+	{
+	}
+
+	template <typename T>
+	T ParameterMapping<T>::ToSearchSpace(T const& value) const
+	{
+		switch (Scale)
+		{
+		case EParameterScale::Log:
+			DLIB_ASSERT(value > 0,
+				"Log scaled parameters must be positive.");
+			return std::log(value);
+		case EParameterScale::Logit:
+			DLIB_ASSERT(value > 0 && value < 1,
+				"Logit scaled parameters must lie strictly between zero and one.");
+			return std::log(value / (1 - value));
+		default:
+			return value;
+		}
+	}
+
+	template <typename T>
+	T ParameterMapping<T>::FromSearchSpace(T const& searchValue) const
+	{
+		switch (Scale)
+		{
+		case EParameterScale::Log:
+			return std::exp(searchValue);
+		case EParameterScale::Logit:
+			return 1 / (1 + std::exp(-searchValue));
+		default:
+			return searchValue;
+		}
+	}
+}
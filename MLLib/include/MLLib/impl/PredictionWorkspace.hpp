@@ -0,0 +1,11 @@
+#pragma once
+
+namespace Regressors
+{
+	template <typename SampleType>
+	PredictionWorkspace<SampleType>& PredictionWorkspace<SampleType>::ThreadLocal()
+	{
+		thread_local PredictionWorkspace workspace;
+		return workspace;
+	}
+}
@@ -113,6 +113,14 @@ namespace PCA
 
 	template<typename SampleType>
 	SampleType PrincipalComponentAnalysis<SampleType>::Encode(SampleType const& data, size_t nModes) const
+	{
+		SampleType params;
+		Encode(data, nModes, params);
+		return params;
+	}
+
+	template<typename SampleType>
+	void PrincipalComponentAnalysis<SampleType>::Encode(SampleType const& data, size_t nModes, SampleType& params) const
 	{
 		DLIB_ASSERT(nVariables() > 0);
 		DLIB_ASSERT(data.size() == nVariables());
@@ -120,20 +128,38 @@ namespace PCA
 
 		nModes = std::min(nParams(), nModes);
 
-		SampleType params(nModes);
-
-		SampleType normData = data - SampleMeans;
+		params.set_size(nModes);
 
+		// the data are centred on the fly rather than into a temporary
 		for (size_t col = 0; col < params.size(); ++col)
 		{
 			params(col) = 0.0;
-			for (size_t row = 0; row < normData.size(); ++row)
+			for (size_t row = 0; row < data.size(); ++row)
 			{
-				params(col) += Eigenvectors[row](col) * normData(row);
+				params(col) += Eigenvectors[row](col) * (data(row) - SampleMeans(row));
 			}
 		}
+	}
 
-		return params;
+	template<typename SampleType>
+	void PrincipalComponentAnalysis<SampleType>::GetAffineTransform(size_t nModes, dlib::matrix<T>& matrix, dlib::matrix<T, 0, 1>& offset) const
+	{
+		DLIB_ASSERT(nVariables() > 0);
+		DLIB_ASSERT(nModes > 0);
+
+		nModes = std::min(nParams(), nModes);
+
+		matrix.set_size(nModes, nVariables());
+		offset.set_size(nModes);
+		for (size_t col = 0; col < nModes; ++col)
+		{
+			offset(col) = 0.0;
+			for (size_t row = 0; row < nVariables(); ++row)
+			{
+				matrix(col, row) = Eigenvectors[row](col);
+				offset(col) -= Eigenvectors[row](col) * SampleMeans(row);
+			}
+		}
 	}
 
 	template<typename SampleType>
@@ -0,0 +1,102 @@
+#pragma once
+#include <dlib/md5.h>
+
+namespace Regressors
+{
+	inline RandomStream::RandomStream(std::string const& randomSeed) :
+		StreamId(0),
+		Counter(0),
+		Buffer(),
+		BufferPosition(Buffer.size())
+	{
+		unsigned char digest[16];
+		dlib::md5(reinterpret_cast<unsigned char const*>(randomSeed.data()), static_cast<unsigned long>(randomSeed.size()), digest);
+		for (size_t i = 0; i < StreamKey.size(); ++i)
+		{
+			StreamKey[i] = static_cast<dlib::uint32>(digest[4 * i]) |
+				static_cast<dlib::uint32>(digest[4 * i + 1]) << 8 |
+				static_cast<dlib::uint32>(digest[4 * i + 2]) << 16 |
+				static_cast<dlib::uint32>(digest[4 * i + 3]) << 24;
+		}
+	}
+
+	inline RandomStream::RandomStream(Key const& key,
+		dlib::uint64 const streamId) :
+		StreamKey(key),
+		StreamId(streamId),
+		Counter(0),
+		Buffer(),
+		BufferPosition(Buffer.size())
+	{
+	}
+
+	inline RandomStream RandomStream::GetSubstream(dlib::uint64 const id) const
+	{
+		// the child's id is a hash of the parent's id and the given id, taken under the complemented key so that it is
+		// unrelated to the numbers any stream draws
+		Block const hashed = Philox({ static_cast<dlib::uint32>(id), static_cast<dlib::uint32>(id >> 32), static_cast<dlib::uint32>(StreamId), static_cast<dlib::uint32>(StreamId >> 32) }, { ~StreamKey[0], ~StreamKey[1] });
+		return RandomStream(StreamKey, static_cast<dlib::uint64>(hashed[0]) | static_cast<dlib::uint64>(hashed[1]) << 32);
+	}
+
+	inline dlib::uint32 RandomStream::GetRandom32BitNumber()
+	{
+		if (BufferPosition == Buffer.size())
+		{
+			Buffer = Philox({ static_cast<dlib::uint32>(Counter), static_cast<dlib::uint32>(Counter >> 32), static_cast<dlib::uint32>(StreamId), static_cast<dlib::uint32>(StreamId >> 32) }, StreamKey);
+			++Counter;
+			BufferPosition = 0;
+		}
+		return Buffer[BufferPosition++];
+	}
+
+	inline dlib::uint64 RandomStream::GetRandom64BitNumber()
+	{
+		dlib::uint64 const low = GetRandom32BitNumber();
+		dlib::uint64 const high = GetRandom32BitNumber();
+		return low | high << 32;
+	}
+
+	inline double RandomStream::GetRandomDouble()
+	{
+		// the top 53 bits fill a double's mantissa exactly
+		return static_cast<double>(GetRandom64BitNumber() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	inline size_t RandomStream::GetRandomIndex(size_t const n)
+	{
+		DLIB_ASSERT(n > 0,
+			"Input parameter n must be greater than zero.");
+
+		// rejection sampling removes the bias of a plain modulo
+		dlib::uint64 const range = static_cast<dlib::uint64>(n);
+		dlib::uint64 const limit = ~dlib::uint64(0) - (~dlib::uint64(0) % range + 1) % range;
+		dlib::uint64 value = GetRandom64BitNumber();
+		while (value > limit)
+		{
+			value = GetRandom64BitNumber();
+		}
+		return static_cast<size_t>(value % range);
+	}
+
+	inline RandomStream::Block RandomStream::Philox(Block counter,
+		Key key)
+	{
+		dlib::uint64 const multiplier0 = 0xD2511F53u;
+		dlib::uint64 const multiplier1 = 0xCD9E8D57u;
+		dlib::uint32 const weyl0 = 0x9E3779B9u;
+		dlib::uint32 const weyl1 = 0xBB67AE85u;
+
+		for (size_t round = 0; round < 10; ++round)
+		{
+			dlib::uint64 const product0 = multiplier0 * counter[0];
+			dlib::uint64 const product1 = multiplier1 * counter[2];
+			counter = { static_cast<dlib::uint32>(product1 >> 32) ^ counter[1] ^ key[0],
+				static_cast<dlib::uint32>(product1),
+				static_cast<dlib::uint32>(product0 >> 32) ^ counter[3] ^ key[1],
+				static_cast<dlib::uint32>(product0) };
+			key[0] += weyl0;
+			key[1] += weyl1;
+		}
+		return counter;
+	}
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 
 namespace Regressors
 {
@@ -13,26 +14,26 @@ namespace Regressors
 
 		template <class KernelType> template <size_t TotalNumParams>
 		KernelRidgeRegression<KernelType>::OneShotTrainingParams::OneShotTrainingParams(col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[0].first)
+			if (optimiseParamsMap[0].Optimise)
 			{
 				MaxBasisFunctions = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				MaxBasisFunctions = optimiseParamsMap[0].second;
+				MaxBasisFunctions = optimiseParamsMap[0].FixedValue;
 			}
-			if (optimiseParamsMap[1].first)
+			if (optimiseParamsMap[1].Optimise)
 			{
 				Lambda = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				Lambda = optimiseParamsMap[1].second;
+				Lambda = optimiseParamsMap[1].FixedValue;
 			}
 			KernelType::UnpackParameters(KernelOneShotTrainingParams, vecParams, optimiseParamsMap, NumRegressionParams, paramsOffset);
 		}
@@ -59,11 +60,12 @@ namespace Regressors
 			UpperMaxBasisFunctions = temp.MaxBasisFunctions;
 			LowerLambda = temp.Lambda;
 			UpperLambda = temp.Lambda;
+			LambdaScale = EParameterScale::Linear;
 		}
 
-		template <class KernelType> template <class... ModifierFunctionTypes>
-		static impl<KernelRidgeRegression<KernelType>, ModifierFunctionTypes...> KernelRidgeRegression<KernelType>::Train(std::vector<SampleType> const& inputExamples,
-			std::vector<T> const& targetExamples,
+		template <class KernelType> template <class SampleContainerType, class TargetContainerType, class... ModifierFunctionTypes>
+		static impl<KernelRidgeRegression<KernelType>, ModifierFunctionTypes...> KernelRidgeRegression<KernelType>::Train(SampleContainerType const& inputExamples,
+			TargetContainerType const& targetExamples,
 			OneShotTrainingParams const& regressionTrainingParams,
 			std::vector<T>& LeaveOneOutValues,
 			T const& trainingError,
@@ -76,6 +78,15 @@ namespace Regressors
 			return impl<KernelRidgeRegression<KernelType>, ModifierFunctionTypes...>(finalTrainer.train(inputExamples, targetExamples, LeaveOneOutValues), modifierFunctions, trainingError, regressionTrainingParams);
 		}
 
+		template <class KernelType>
+		void KernelRidgeRegression<KernelType>::AppendRegressionParamsAxes(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.MaxBasisFunctionsToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.LambdaToTry.size());
+			KernelType::AppendKernelParamsAxes(regressionCrossValidationTrainingParams.KernelCrossValidationTrainingParams, numValuesPerAxis);
+		}
+
 		template <class KernelType>
 		void KernelRidgeRegression<KernelType>::IterateRegressionParams(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 			std::vector<OneShotTrainingParams>& regressionParamSets)
@@ -100,17 +111,17 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[0].first)
+			if (optimiseParamsMap[0].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerMaxBasisFunctions;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperMaxBasisFunctions;
 				isIntegerParam[paramsOffset] = true;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[1].first)
+			if (optimiseParamsMap[1].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerLambda;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperLambda;
@@ -122,15 +133,34 @@ namespace Regressors
 
 		template <class KernelType> template <size_t TotalNumParams>
 		static void KernelRidgeRegression<KernelType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap)
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap)
 		{
-			optimiseParamsMap[0].first = fmgTrainingParams.LowerMaxBasisFunctions != fmgTrainingParams.UpperMaxBasisFunctions;
-			optimiseParamsMap[0].second = fmgTrainingParams.LowerMaxBasisFunctions;
-			optimiseParamsMap[1].first = fmgTrainingParams.LowerLambda != fmgTrainingParams.UpperLambda;
-			optimiseParamsMap[1].second = fmgTrainingParams.LowerLambda;
+			optimiseParamsMap[0].Optimise = fmgTrainingParams.LowerMaxBasisFunctions != fmgTrainingParams.UpperMaxBasisFunctions;
+			optimiseParamsMap[0].FixedValue = fmgTrainingParams.LowerMaxBasisFunctions;
+			optimiseParamsMap[1].Optimise = fmgTrainingParams.LowerLambda != fmgTrainingParams.UpperLambda;
+			optimiseParamsMap[1].FixedValue = fmgTrainingParams.LowerLambda;
+			optimiseParamsMap[1].Scale = fmgTrainingParams.LambdaScale;
 			KernelType::ConfigureMapping(fmgTrainingParams.KernelFindMinGlobalTrainingParams, optimiseParamsMap, NumRegressionParams);
 		}
 
+		template <class KernelType>
+		void KernelRidgeRegression<KernelType>::SerializeCacheKey(OneShotTrainingParams const& regressionTrainingParams,
+			std::ostream& out)
+		{
+			serialize(regressionTrainingParams, out);
+		}
+
+		template <class KernelType>
+		size_t KernelRidgeRegression<KernelType>::EstimatePeakMemory(OneShotTrainingParams const& regressionTrainingParams,
+			size_t const numExamples,
+			size_t const numOrdinates)
+		{
+			// the linearly independent subset holds up to MaxBasisFunctions samples and their kernel matrix, every example is
+			// projected onto it, and the solve works on a few basis-sized square matrices
+			size_t const numBasis = std::min<size_t>(regressionTrainingParams.MaxBasisFunctions, numExamples);
+			return sizeof(T) * (numExamples * numOrdinates + numBasis * numOrdinates + numExamples * numBasis + 4 * numBasis * numBasis + 4 * numExamples);
+		}
+
 		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 		template <class KernelType>
@@ -144,44 +174,44 @@ namespace Regressors
 
 		template <class KernelType> template <size_t TotalNumParams>
 		SupportVectorRegression<KernelType>::OneShotTrainingParams::OneShotTrainingParams(col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[0].first)
+			if (optimiseParamsMap[0].Optimise)
 			{
 				C = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				C = optimiseParamsMap[0].second;
+				C = optimiseParamsMap[0].FixedValue;
 			}
-			if (optimiseParamsMap[1].first)
+			if (optimiseParamsMap[1].Optimise)
 			{
 				Epsilon = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				Epsilon = optimiseParamsMap[1].second;
+				Epsilon = optimiseParamsMap[1].FixedValue;
 			}
-			if (optimiseParamsMap[2].first)
+			if (optimiseParamsMap[2].Optimise)
 			{
 				EpsilonInsensitivity = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				EpsilonInsensitivity = optimiseParamsMap[2].second;
+				EpsilonInsensitivity = optimiseParamsMap[2].FixedValue;
 			}
-			if (optimiseParamsMap[3].first)
+			if (optimiseParamsMap[3].Optimise)
 			{
 				CacheSize = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				CacheSize = optimiseParamsMap[3].second;
+				CacheSize = optimiseParamsMap[3].FixedValue;
 			}
 			KernelType::UnpackParameters(KernelOneShotTrainingParams, vecParams, optimiseParamsMap, NumRegressionParams, paramsOffset);
 		}
@@ -208,17 +238,20 @@ namespace Regressors
 			OneShotTrainingParams temp;
 			LowerC = temp.C;
 			UpperC = temp.C;
+			CScale = EParameterScale::Linear;
 			LowerEpsilon = temp.Epsilon;
 			UpperEpsilon = temp.Epsilon;
+			EpsilonScale = EParameterScale::Linear;
 			LowerEpsilonInsensitivity = temp.EpsilonInsensitivity;
 			UpperEpsilonInsensitivity = temp.EpsilonInsensitivity;
+			EpsilonInsensitivityScale = EParameterScale::Linear;
 			LowerCacheSize = temp.CacheSize;
 			UpperCacheSize = temp.CacheSize;
 		}
 
-		template <class KernelType> template <class... ModifierFunctionTypes>
-		static impl<SupportVectorRegression<KernelType>, ModifierFunctionTypes...> SupportVectorRegression<KernelType>::Train(std::vector<SampleType> const& inputExamples,
-			std::vector<T> const& targetExamples,
+		template <class KernelType> template <class SampleContainerType, class TargetContainerType, class... ModifierFunctionTypes>
+		static impl<SupportVectorRegression<KernelType>, ModifierFunctionTypes...> SupportVectorRegression<KernelType>::Train(SampleContainerType const& inputExamples,
+			TargetContainerType const& targetExamples,
 			OneShotTrainingParams const& regressionTrainingParams,
 			std::vector<T>& Residuals,
 			T const& trainingError,
@@ -239,6 +272,17 @@ namespace Regressors
 			return impl<SupportVectorRegression<KernelType>, ModifierFunctionTypes...>(df, modifierFunctions, trainingError, regressionTrainingParams);
 		}
 
+		template <class KernelType>
+		void SupportVectorRegression<KernelType>::AppendRegressionParamsAxes(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.CToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.EpsilonToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.EpsilonInsensitivityToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.CacheSizeToTry.size());
+			KernelType::AppendKernelParamsAxes(regressionCrossValidationTrainingParams.KernelCrossValidationTrainingParams, numValuesPerAxis);
+		}
+
 		template <class KernelType>
 		void SupportVectorRegression<KernelType>::IterateRegressionParams(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 			std::vector<OneShotTrainingParams>& regressionParamSets)
@@ -271,31 +315,31 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[0].first)
+			if (optimiseParamsMap[0].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerC;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperC;
-				isIntegerParam[paramsOffset] = true;
+				isIntegerParam[paramsOffset] = false;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[1].first)
+			if (optimiseParamsMap[1].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerEpsilon;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperEpsilon;
 				isIntegerParam[paramsOffset] = false;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[2].first)
+			if (optimiseParamsMap[2].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerEpsilonInsensitivity;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperEpsilonInsensitivity;
 				isIntegerParam[paramsOffset] = false;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[3].first)
+			if (optimiseParamsMap[3].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerCacheSize;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperCacheSize;
@@ -307,19 +351,41 @@ namespace Regressors
 
 		template <class KernelType> template <size_t TotalNumParams>
 		static void SupportVectorRegression<KernelType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap)
-		{
-			optimiseParamsMap[0].first = fmgTrainingParams.LowerC != fmgTrainingParams.UpperC;
-			optimiseParamsMap[0].second = fmgTrainingParams.LowerC;
-			optimiseParamsMap[1].first = fmgTrainingParams.LowerEpsilon != fmgTrainingParams.UpperEpsilon;
-			optimiseParamsMap[1].second = fmgTrainingParams.LowerEpsilon;
-			optimiseParamsMap[2].first = fmgTrainingParams.LowerEpsilonInsensitivity != fmgTrainingParams.UpperEpsilonInsensitivity;
-			optimiseParamsMap[2].second = fmgTrainingParams.LowerEpsilonInsensitivity;
-			optimiseParamsMap[3].first = fmgTrainingParams.LowerCacheSize != fmgTrainingParams.UpperCacheSize;
-			optimiseParamsMap[3].second = fmgTrainingParams.LowerCacheSize;
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap)
+		{
+			optimiseParamsMap[0].Optimise = fmgTrainingParams.LowerC != fmgTrainingParams.UpperC;
+			optimiseParamsMap[0].FixedValue = fmgTrainingParams.LowerC;
+			optimiseParamsMap[0].Scale = fmgTrainingParams.CScale;
+			optimiseParamsMap[1].Optimise = fmgTrainingParams.LowerEpsilon != fmgTrainingParams.UpperEpsilon;
+			optimiseParamsMap[1].FixedValue = fmgTrainingParams.LowerEpsilon;
+			optimiseParamsMap[1].Scale = fmgTrainingParams.EpsilonScale;
+			optimiseParamsMap[2].Optimise = fmgTrainingParams.LowerEpsilonInsensitivity != fmgTrainingParams.UpperEpsilonInsensitivity;
+			optimiseParamsMap[2].FixedValue = fmgTrainingParams.LowerEpsilonInsensitivity;
+			optimiseParamsMap[2].Scale = fmgTrainingParams.EpsilonInsensitivityScale;
+			optimiseParamsMap[3].Optimise = fmgTrainingParams.LowerCacheSize != fmgTrainingParams.UpperCacheSize;
+			optimiseParamsMap[3].FixedValue = fmgTrainingParams.LowerCacheSize;
 			KernelType::ConfigureMapping(fmgTrainingParams.KernelFindMinGlobalTrainingParams, optimiseParamsMap, NumRegressionParams);
 		}
 
+		template <class KernelType>
+		void SupportVectorRegression<KernelType>::SerializeCacheKey(OneShotTrainingParams const& regressionTrainingParams,
+			std::ostream& out)
+		{
+			// the kernel cache size only affects training speed, so it is left out of the key
+			OneShotTrainingParams keyParams(regressionTrainingParams);
+			keyParams.CacheSize = 0;
+			serialize(keyParams, out);
+		}
+
+		template <class KernelType>
+		size_t SupportVectorRegression<KernelType>::EstimatePeakMemory(OneShotTrainingParams const& regressionTrainingParams,
+			size_t const numExamples,
+			size_t const numOrdinates)
+		{
+			// the kernel cache is CacheSize megabytes, on top of the solver's per-example alphas and gradients
+			return static_cast<size_t>(std::max(regressionTrainingParams.CacheSize, 0l)) * 1024 * 1024 + sizeof(T) * (numExamples * numOrdinates + 8 * numExamples);
+		}
+
 		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 		template <class ExtractorType>
@@ -332,35 +398,35 @@ namespace Regressors
 
 		template <class ExtractorType> template <size_t TotalNumParams>
 		RandomForestRegression<ExtractorType>::OneShotTrainingParams::OneShotTrainingParams(col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[0].first)
+			if (optimiseParamsMap[0].Optimise)
 			{
 				NumTrees = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				NumTrees = optimiseParamsMap[0].second;
+				NumTrees = optimiseParamsMap[0].FixedValue;
 			}
-			if (optimiseParamsMap[1].first)
+			if (optimiseParamsMap[1].Optimise)
 			{
 				MinSamplesPerLeaf = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				MinSamplesPerLeaf = optimiseParamsMap[1].second;
+				MinSamplesPerLeaf = optimiseParamsMap[1].FixedValue;
 			}
-			if (optimiseParamsMap[2].first)
+			if (optimiseParamsMap[2].Optimise)
 			{
 				SubsamplingFraction = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				SubsamplingFraction = optimiseParamsMap[2].second;
+				SubsamplingFraction = optimiseParamsMap[2].FixedValue;
 			}
 			ExtractorType::UnpackParameters(ExtractorOneShotTrainingParams, vecParams, optimiseParamsMap, NumRegressionParams, paramsOffset);
 		}
@@ -390,11 +456,12 @@ namespace Regressors
 			UpperMinSamplesPerLeaf = temp.MinSamplesPerLeaf;
 			LowerSubsamplingFraction = temp.SubsamplingFraction;
 			UpperSubsamplingFraction = temp.SubsamplingFraction;
+			SubsamplingFractionScale = EParameterScale::Linear;
 		}
 
-		template <class ExtractorType> template <class... ModifierFunctionTypes>
-		static impl<RandomForestRegression<ExtractorType>, ModifierFunctionTypes...> RandomForestRegression<ExtractorType>::Train(std::vector<SampleType> const& inputExamples,
-			std::vector<T> const& targetExamples,
+		template <class ExtractorType> template <class SampleContainerType, class TargetContainerType, class... ModifierFunctionTypes>
+		static impl<RandomForestRegression<ExtractorType>, ModifierFunctionTypes...> RandomForestRegression<ExtractorType>::Train(SampleContainerType const& inputExamples,
+			TargetContainerType const& targetExamples,
 			OneShotTrainingParams const& regressionTrainingParams,
 			std::vector<T>& OutOfBagValues,
 			T const& trainingError,
@@ -405,7 +472,20 @@ namespace Regressors
 			finalTrainer.set_num_trees(regressionTrainingParams.NumTrees);
 			finalTrainer.set_min_samples_per_leaf(regressionTrainingParams.MinSamplesPerLeaf);
 			finalTrainer.set_feature_subsampling_fraction(regressionTrainingParams.SubsamplingFraction);
-			return impl<RandomForestRegression<ExtractorType>, ModifierFunctionTypes...>(finalTrainer.train(inputExamples, targetExamples, OutOfBagValues), modifierFunctions, trainingError, regressionTrainingParams);
+			// dlib's random forest trainer only accepts std::vector inputs, so fold views are materialised here
+			auto const& examples = AsStdVector(inputExamples);
+			auto const& targets = AsStdVector(targetExamples);
+			return impl<RandomForestRegression<ExtractorType>, ModifierFunctionTypes...>(finalTrainer.train(examples, targets, OutOfBagValues), modifierFunctions, trainingError, regressionTrainingParams);
+		}
+
+		template <class ExtractorType>
+		void RandomForestRegression<ExtractorType>::AppendRegressionParamsAxes(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.NumTreesToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.MinSamplesPerLeafToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.SubsamplingFractionToTry.size());
+			ExtractorType::AppendExtractorParamsAxes(regressionCrossValidationTrainingParams.ExtractorCrossValidationTrainingParams, numValuesPerAxis);
 		}
 
 		template <class ExtractorType>
@@ -436,24 +516,24 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[0].first)
+			if (optimiseParamsMap[0].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerNumTrees;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperNumTrees;
 				isIntegerParam[paramsOffset] = true;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[1].first)
+			if (optimiseParamsMap[1].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerMinSamplesPerLeaf;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperMinSamplesPerLeaf;
 				isIntegerParam[paramsOffset] = true;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[2].first)
+			if (optimiseParamsMap[2].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerSubsamplingFraction;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperSubsamplingFraction;
@@ -465,17 +545,35 @@ namespace Regressors
 
 		template <class ExtractorType> template <size_t TotalNumParams>
 		static void RandomForestRegression<ExtractorType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap)
-		{
-			optimiseParamsMap[0].first = fmgTrainingParams.LowerNumTrees != fmgTrainingParams.UpperNumTrees;
-			optimiseParamsMap[0].second = fmgTrainingParams.LowerNumTrees;
-			optimiseParamsMap[1].first = fmgTrainingParams.LowerMinSamplesPerLeaf != fmgTrainingParams.UpperMinSamplesPerLeaf;
-			optimiseParamsMap[1].second = fmgTrainingParams.LowerMinSamplesPerLeaf;
-			optimiseParamsMap[2].first = fmgTrainingParams.LowerSubsamplingFraction != fmgTrainingParams.UpperSubsamplingFraction;
-			optimiseParamsMap[2].second = fmgTrainingParams.LowerSubsamplingFraction;
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap)
+		{
+			optimiseParamsMap[0].Optimise = fmgTrainingParams.LowerNumTrees != fmgTrainingParams.UpperNumTrees;
+			optimiseParamsMap[0].FixedValue = fmgTrainingParams.LowerNumTrees;
+			optimiseParamsMap[1].Optimise = fmgTrainingParams.LowerMinSamplesPerLeaf != fmgTrainingParams.UpperMinSamplesPerLeaf;
+			optimiseParamsMap[1].FixedValue = fmgTrainingParams.LowerMinSamplesPerLeaf;
+			optimiseParamsMap[2].Optimise = fmgTrainingParams.LowerSubsamplingFraction != fmgTrainingParams.UpperSubsamplingFraction;
+			optimiseParamsMap[2].FixedValue = fmgTrainingParams.LowerSubsamplingFraction;
+			optimiseParamsMap[2].Scale = fmgTrainingParams.SubsamplingFractionScale;
 			ExtractorType::ConfigureMapping(fmgTrainingParams.ExtractorFindMinGlobalTrainingParams, optimiseParamsMap, NumRegressionParams);
 		}
 
+		template <class ExtractorType>
+		void RandomForestRegression<ExtractorType>::SerializeCacheKey(OneShotTrainingParams const& regressionTrainingParams,
+			std::ostream& out)
+		{
+			serialize(regressionTrainingParams, out);
+		}
+
+		template <class ExtractorType>
+		size_t RandomForestRegression<ExtractorType>::EstimatePeakMemory(OneShotTrainingParams const& regressionTrainingParams,
+			size_t const numExamples,
+			size_t const numOrdinates)
+		{
+			// the examples are materialised for dlib's trainer, and each tree holds up to two nodes per leaf
+			size_t const numNodesPerTree = 2 * (numExamples / std::max<size_t>(regressionTrainingParams.MinSamplesPerLeaf, 1) + 1);
+			return sizeof(T) * (2 * numExamples * numOrdinates + 4 * numExamples) + regressionTrainingParams.NumTrees * numNodesPerTree * (sizeof(T) + 2 * sizeof(dlib::uint32));
+		}
+
 		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 		template <class LinkFunctionType>
@@ -489,44 +587,44 @@ namespace Regressors
 
 		template <class LinkFunctionType> template <size_t TotalNumParams>
 		IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::OneShotTrainingParams::OneShotTrainingParams(col_vector<T> const& vecParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[0].first)
+			if (optimiseParamsMap[0].Optimise)
 			{
 				MaxNumIterations = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				MaxNumIterations = optimiseParamsMap[0].second;
+				MaxNumIterations = optimiseParamsMap[0].FixedValue;
 			}
-			if (optimiseParamsMap[1].first)
+			if (optimiseParamsMap[1].Optimise)
 			{
 				ConvergenceTolerance = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				ConvergenceTolerance = optimiseParamsMap[0].second;
+				ConvergenceTolerance = optimiseParamsMap[1].FixedValue;
 			}
-			if (optimiseParamsMap[2].first)
+			if (optimiseParamsMap[2].Optimise)
 			{
 				MaxBasisFunctions = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				MaxBasisFunctions = optimiseParamsMap[0].second;
+				MaxBasisFunctions = optimiseParamsMap[2].FixedValue;
 			}
-			if (optimiseParamsMap[3].first)
+			if (optimiseParamsMap[3].Optimise)
 			{
 				Lambda = vecParams(paramsOffset);
 				++paramsOffset;
 			}
 			else
 			{
-				Lambda = optimiseParamsMap[1].second;
+				Lambda = optimiseParamsMap[3].FixedValue;
 			}
 			LinkFunctionType::UnpackParameters(LinkFunctionOneShotTrainingParams, vecParams, optimiseParamsMap, NumRegressionParams, paramsOffset);
 			KernelType::UnpackParameters(KernelOneShotTrainingParams, vecParams, optimiseParamsMap, NumRegressionParams + LinkFunctionType::NumLinkFunctionParams, paramsOffset);
@@ -556,15 +654,17 @@ namespace Regressors
 			UpperMaxNumIterations = temp.MaxNumIterations;
 			LowerConvergenceTolerance = temp.ConvergenceTolerance;
 			UpperConvergenceTolerance = temp.ConvergenceTolerance;
+			ConvergenceToleranceScale = EParameterScale::Linear;
 			LowerMaxBasisFunctions = temp.MaxBasisFunctions;
 			UpperMaxBasisFunctions = temp.MaxBasisFunctions;
 			LowerLambda = temp.Lambda;
 			UpperLambda = temp.Lambda;
+			LambdaScale = EParameterScale::Linear;
 		}
 
-		template <class LinkFunctionType> template <class... ModifierFunctionTypes>
-		static impl<IterativelyReweightedLeastSquaresRegression<LinkFunctionType>, ModifierFunctionTypes...> IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::Train(std::vector<SampleType> const& inputExamples,
-			std::vector<T> const& targetExamples,
+		template <class LinkFunctionType> template <class SampleContainerType, class TargetContainerType, class... ModifierFunctionTypes>
+		static impl<IterativelyReweightedLeastSquaresRegression<LinkFunctionType>, ModifierFunctionTypes...> IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::Train(SampleContainerType const& inputExamples,
+			TargetContainerType const& targetExamples,
 			OneShotTrainingParams const& regressionTrainingParams,
 			std::vector<T>& Residuals,
 			T const& trainingError,
@@ -586,6 +686,17 @@ namespace Regressors
 			return impl<IterativelyReweightedLeastSquaresRegression<LinkFunctionType>, ModifierFunctionTypes...>(df, modifierFunctions, trainingError, regressionTrainingParams);
 		}
 
+		template <class LinkFunctionType>
+		void IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::AppendRegressionParamsAxes(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+			std::vector<size_t>& numValuesPerAxis)
+		{
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.MaxNumIterationsToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.ConvergenceToleranceToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.MaxBasisFunctionsToTry.size());
+			numValuesPerAxis.push_back(regressionCrossValidationTrainingParams.LambdaToTry.size());
+			LinkFunctionType::AppendLinkFunctionParamsAxes(regressionCrossValidationTrainingParams.LinkFunctionCrossValidationTrainingParams, regressionCrossValidationTrainingParams.KernelCrossValidationTrainingParams, numValuesPerAxis);
+		}
+
 		template <class LinkFunctionType>
 		void IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::IterateRegressionParams(CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 			std::vector<OneShotTrainingParams>& regressionParamSets)
@@ -621,31 +732,31 @@ namespace Regressors
 			col_vector<T>& upperBound,
 			std::vector<bool>& isIntegerParam,
 			FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+			std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 			size_t& paramsOffset)
 		{
-			if (optimiseParamsMap[0].first)
+			if (optimiseParamsMap[0].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerMaxNumIterations;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperMaxNumIterations;
 				isIntegerParam[paramsOffset] = true;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[1].first)
+			if (optimiseParamsMap[1].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerConvergenceTolerance;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperConvergenceTolerance;
 				isIntegerParam[paramsOffset] = false;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[2].first)
+			if (optimiseParamsMap[2].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerMaxBasisFunctions;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperMaxBasisFunctions;
 				isIntegerParam[paramsOffset] = true;
 				++paramsOffset;
 			}
-			if (optimiseParamsMap[3].first)
+			if (optimiseParamsMap[3].Optimise)
 			{
 				lowerBound(paramsOffset) = fmgTrainingParams.LowerLambda;
 				upperBound(paramsOffset) = fmgTrainingParams.UpperLambda;
@@ -658,18 +769,41 @@ namespace Regressors
 
 		template <class LinkFunctionType> template <size_t TotalNumParams>
 		static void IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::ConfigureMapping(FindMinGlobalTrainingParams const& fmgTrainingParams,
-			std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap)
-		{
-			optimiseParamsMap[0].first = fmgTrainingParams.LowerMaxNumIterations != fmgTrainingParams.UpperMaxNumIterations;
-			optimiseParamsMap[0].second = fmgTrainingParams.LowerMaxNumIterations;
-			optimiseParamsMap[1].first = fmgTrainingParams.LowerConvergenceTolerance != fmgTrainingParams.UpperConvergenceTolerance;
-			optimiseParamsMap[1].second = fmgTrainingParams.LowerConvergenceTolerance;
-			optimiseParamsMap[2].first = fmgTrainingParams.LowerMaxBasisFunctions != fmgTrainingParams.UpperMaxBasisFunctions;
-			optimiseParamsMap[2].second = fmgTrainingParams.LowerMaxBasisFunctions;
-			optimiseParamsMap[3].first = fmgTrainingParams.LowerLambda != fmgTrainingParams.UpperLambda;
-			optimiseParamsMap[3].second = fmgTrainingParams.LowerLambda;
+			std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap)
+		{
+			optimiseParamsMap[0].Optimise = fmgTrainingParams.LowerMaxNumIterations != fmgTrainingParams.UpperMaxNumIterations;
+			optimiseParamsMap[0].FixedValue = fmgTrainingParams.LowerMaxNumIterations;
+			optimiseParamsMap[1].Optimise = fmgTrainingParams.LowerConvergenceTolerance != fmgTrainingParams.UpperConvergenceTolerance;
+			optimiseParamsMap[1].FixedValue = fmgTrainingParams.LowerConvergenceTolerance;
+			optimiseParamsMap[1].Scale = fmgTrainingParams.ConvergenceToleranceScale;
+			optimiseParamsMap[2].Optimise = fmgTrainingParams.LowerMaxBasisFunctions != fmgTrainingParams.UpperMaxBasisFunctions;
+			optimiseParamsMap[2].FixedValue = fmgTrainingParams.LowerMaxBasisFunctions;
+			optimiseParamsMap[3].Optimise = fmgTrainingParams.LowerLambda != fmgTrainingParams.UpperLambda;
+			optimiseParamsMap[3].FixedValue = fmgTrainingParams.LowerLambda;
+			optimiseParamsMap[3].Scale = fmgTrainingParams.LambdaScale;
 			LinkFunctionType::ConfigureMapping(fmgTrainingParams.LinkFunctionFindMinGlobalTrainingParams, optimiseParamsMap, NumRegressionParams);
 			KernelType::ConfigureMapping(fmgTrainingParams.KernelFindMinGlobalTrainingParams, optimiseParamsMap, NumRegressionParams + LinkFunctionType::NumLinkFunctionParams);
 		}
+
+		template <class LinkFunctionType>
+		void IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::SerializeCacheKey(OneShotTrainingParams const& regressionTrainingParams,
+			std::ostream& out)
+		{
+			// every link function shares one regressor type enum, so the link function and its kernel are keyed by their own
+			// enums, which unlike type names are the same on every compiler and build
+			serialize(LinkFunctionType::LinkFunctionTypeEnum, out);
+			serialize(KernelType::KernelTypeEnum, out);
+			serialize(regressionTrainingParams, out);
+		}
+
+		template <class LinkFunctionType>
+		size_t IterativelyReweightedLeastSquaresRegression<LinkFunctionType>::EstimatePeakMemory(OneShotTrainingParams const& regressionTrainingParams,
+			size_t const numExamples,
+			size_t const numOrdinates)
+		{
+			// as for kernel ridge regression, plus the weights and working responses of each reweighting iteration
+			size_t const numBasis = std::min<size_t>(regressionTrainingParams.MaxBasisFunctions, numExamples);
+			return sizeof(T) * (numExamples * numOrdinates + numBasis * numOrdinates + numExamples * numBasis + 4 * numBasis * numBasis + 8 * numExamples);
+		}
 	}
 }
\ No newline at end of file
@@ -3,98 +3,342 @@
 #include <dlib/svm.h>
 #include <dlib/threads.h>
 #include <dlib/global_optimization.h>
+#include <dlib/md5.h>
 #include <type_traits>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
 
 namespace Regressors
 {
 	template <class RegressionType, class... ModifierOneShotParamsTypes>
 	static typename RegressionType::SampleType::type RegressorTrainer::CrossValidate(const std::vector<typename RegressionType::SampleType>& inputExamples,
 		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
-		std::string const& randomSeed,
+		FoldPlan const& foldPlan,
 		typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
-		size_t const numFolds,
 		ECrossValidationMetric const metric,
-		std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams)
+		std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		ModifiedFold<typename RegressionType::SampleType, typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...>* const modifiedFolds,
+		RaceState<typename RegressionType::SampleType::type>* const race,
+		CrossValidationReport<typename RegressionType::SampleType::type>& report,
+		dlib::thread_pool& tp)
 	{
+		typedef typename RegressionType::SampleType SampleType;
 		typedef typename RegressionType::T T;
-		size_t const numExamples = inputExamples.size();
-		size_t const numOrdinates = inputExamples.begin()->size();
-		size_t const chunks = numExamples / numFolds;
-
-		DLIB_ASSERT(numFolds > 0 && numFolds < numExamples,
-			"Input parameter numFolds must be greater than zero and less than the provided number of examples.");
-
-		dlib::running_stats<T> rs_abs;
-		dlib::running_stats<T> rs_sq;
-		dlib::running_scalar_covariance<T> rs_rc;
 
+		DLIB_ASSERT(foldPlan.GetNumExamples() == inputExamples.size(),
+			"Fold plan was built for a different number of examples.");
+
+		size_t const numFolds = foldPlan.GetNumFolds();
+		std::vector<std::vector<T>> foldPredictions(numFolds);
+		std::vector<std::exception_ptr> foldErrors(numFolds);
+		std::vector<double> foldSeconds(numFolds);
+		std::vector<dlib::uint64> foldTaskIds(numFolds);
+		std::mutex raceMutex;
+		dlib::running_stats<T> completedFoldScores;
+		std::atomic<bool> outOfRace(false);
+		std::atomic<bool> stopped(false);
+		// the folds train on near enough the same number of examples for one estimate to admit each of them
+		size_t const foldMemory = options.TaskMemoryBudget != nullptr && numFolds > 0 ?
+			RegressionType::EstimatePeakMemory(regressionOneShotTrainingParams, foldPlan.GetTrainIndices(0).size(), inputExamples.empty() ? 0 : static_cast<size_t>(inputExamples[0].size())) :
+			0;
 		for (size_t fold = 0; fold < numFolds; ++fold)
 		{
-			size_t const testStartIndex = fold * chunks;
-			size_t const testEndIndex = fold == numFolds ? numExamples : (fold + 1) * chunks;
-			size_t const numTestExamples = testEndIndex - testStartIndex;
-			std::vector<col_vector<T>> foldTrainExamples(numExamples - numTestExamples, col_vector<T>(numOrdinates));
-			std::vector<T> foldTrainTargets(numExamples - numTestExamples);
-			std::vector<col_vector<T>> foldTestExamples(numTestExamples, col_vector<T>(numOrdinates));
-			std::vector<T> foldTestTargets(numTestExamples);
+			foldTaskIds[fold] = tp.add_task_by_value([&, fold]()
+				{
+					if (outOfRace || stopped)
+					{
+						return;
+					}
+					// racing or a stop may make the fold unnecessary while it waits for room in the memory budget
+					MemoryAdmission const admission(options.TaskMemoryBudget, foldMemory);
+					if (outOfRace || stopped)
+					{
+						return;
+					}
+					if (options.IsStopRequested())
+					{
+						stopped = true;
+						return;
+					}
+					try
+					{
+						auto const foldStart = std::chrono::steady_clock::now();
+						std::vector<size_t> const& foldTrainIndices = foldPlan.GetTrainIndices(fold);
+						IndexedVectorView<SampleType> const foldTrainExamples(inputExamples, foldTrainIndices);
+						IndexedVectorView<T> const foldTrainTargets(targetExamples, foldTrainIndices);
+
+						std::tuple<typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...> modifierFunctions;
+						std::vector<T> additionalDiagnostics;
+						auto const predictor = modifiedFolds != nullptr ?
+							TrainOnModifiedFold<RegressionType>(foldTrainExamples,
+								foldTrainTargets,
+								regressionOneShotTrainingParams,
+								modifierOneShotTrainingParams,
+								modifiedFolds[fold]) :
+							TrainModifiersAndRegressor<RegressionType>(foldTrainExamples,
+								foldTrainTargets,
+								regressionOneShotTrainingParams,
+								additionalDiagnostics,
+								0.0,
+								modifierOneShotTrainingParams,
+								modifierFunctions);
+
+						std::vector<size_t> const& foldTestIndices = foldPlan.GetTestIndices(fold);
+						foldPredictions[fold].resize(foldTestIndices.size());
+						for (size_t i = 0; i < foldTestIndices.size(); ++i)
+						{
+							foldPredictions[fold][i] = predictor.PredictThroughModifiers(inputExamples[foldTestIndices[i]], PredictionWorkspace<SampleType>::ThreadLocal());
+						}
+						foldSeconds[fold] = std::chrono::duration<double>(std::chrono::steady_clock::now() - foldStart).count();
+
+						if (race != nullptr)
+						{
+							dlib::running_stats<T> foldScore;
+							for (size_t i = 0; i < foldTestIndices.size(); ++i)
+							{
+								T const diff = foldPredictions[fold][i] - targetExamples[foldTestIndices[i]];
+								foldScore.add(metric == ECrossValidationMetric::SumSquareMean ? diff * diff : std::abs(diff));
+							}
+
+							std::lock_guard<std::mutex> lock(raceMutex);
+							completedFoldScores.add(foldScore.mean());
+							if (IsOutOfRace(*race, completedFoldScores, numFolds))
+							{
+								outOfRace = true;
+							}
+						}
+					}
+					catch (...)
+					{
+						foldErrors[fold] = std::current_exception();
+					}
+				});
+		}
+		for (auto const taskId : foldTaskIds)
+		{
+			tp.wait_for_task(taskId);
+		}
 
-			std::vector<size_t> randomIndices(numExamples);
-			std::iota(randomIndices.begin(), randomIndices.end(), 0);
-			dlib::rand rng(randomSeed);
-			dlib::randomize_samples(randomIndices, rng);
-			for (size_t i = 0; i < testStartIndex; ++i)
-			{
-				foldTrainExamples[i] = inputExamples[randomIndices[i]];
-				foldTrainTargets[i] = targetExamples[randomIndices[i]];
-			}
-			for (size_t i = testStartIndex; i < testEndIndex; ++i)
-			{
-				foldTestExamples[i - testStartIndex] = inputExamples[randomIndices[i]];
-				foldTestTargets[i - testStartIndex] = targetExamples[randomIndices[i]];
-			}
-			for (size_t i = testEndIndex; i < numExamples; ++i)
+		// a failed fold is an error in the parameter set, which racing or a stop that happened alongside it must not hide
+		for (auto const& foldError : foldErrors)
+		{
+			if (foldError)
 			{
-				foldTrainExamples[i - numTestExamples] = inputExamples[randomIndices[i]];
-				foldTrainTargets[i - numTestExamples] = targetExamples[randomIndices[i]];
+				std::rethrow_exception(foldError);
 			}
+		}
 
-			std::tuple<typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...> modifierFunctions;
-			std::vector<T> additionalDiagnostics;
-			auto const predictor = TrainModifiersAndRegressor<RegressionType>(foldTrainExamples, 
-				foldTrainTargets,
-				regressionOneShotTrainingParams, 
-				additionalDiagnostics,
-				0.0,
-				modifierOneShotTrainingParams,
-				modifierFunctions);
-			for (size_t i = 0; i < numTestExamples; ++i)
+		if (outOfRace)
+		{
+			++race->NumPruned;
+			return std::numeric_limits<T>::infinity();
+		}
+		if (stopped)
+		{
+			return std::numeric_limits<T>::infinity();
+		}
+
+		// folds finish in any order, so the statistics are accumulated afterwards in fold order to keep the result deterministic
+		dlib::running_stats<T> rs_abs;
+		dlib::running_stats<T> rs_sq;
+		dlib::running_scalar_covariance<T> rs_rc;
+		report.FoldMetrics.resize(numFolds);
+		report.FoldSeconds = foldSeconds;
+		for (size_t fold = 0; fold < numFolds; ++fold)
+		{
+			dlib::running_stats<T> fold_rs_abs;
+			dlib::running_stats<T> fold_rs_sq;
+			dlib::running_scalar_covariance<T> fold_rs_rc;
+			std::vector<size_t> const& foldTestIndices = foldPlan.GetTestIndices(fold);
+			for (size_t i = 0; i < foldTestIndices.size(); ++i)
 			{
-				T result = predictor.Predict(foldTestExamples[i]);
+				T const& result = foldPredictions[fold][i];
+				T const& target = targetExamples[foldTestIndices[i]];
 
-				T diff = result - foldTestTargets[i];
+				T diff = result - target;
 				rs_abs.add(std::abs(diff));
 				rs_sq.add(diff * diff);
-				rs_rc.add(result, foldTestTargets[i]);
+				rs_rc.add(result, target);
+				fold_rs_abs.add(std::abs(diff));
+				fold_rs_sq.add(diff * diff);
+				fold_rs_rc.add(result, target);
 			}
+			report.FoldMetrics[fold] = CrossValidationMetrics<T>(fold_rs_abs, fold_rs_sq, fold_rs_rc);
 		}
+		report.Metrics = CrossValidationMetrics<T>(rs_abs, rs_sq, rs_rc);
+
+		return GetCrossValidationMetric(metric, report.Metrics);
+	}
+
+	template <class RegressionType, class... ModifierOneShotParamsTypes>
+	static typename RegressionType::SampleType::type RegressorTrainer::ScoreSingleFit(std::vector<typename RegressionType::SampleType> const& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+		ECrossValidationMetric const metric,
+		ECrossValidationStrategy const strategy,
+		std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams,
+		CrossValidationReport<typename RegressionType::SampleType::type>& report)
+	{
+		typedef typename RegressionType::SampleType::type T;
+
+		if (strategy == ECrossValidationStrategy::AnalyticLOO && !RegressionType::ProvidesLeaveOneOutValues)
+		{
+			throw RegressorError("Analytic leave-one-out scoring is not available for this regression type.");
+		}
+		if (strategy == ECrossValidationStrategy::OutOfBag && !RegressionType::ProvidesOutOfBagValues)
+		{
+			throw RegressorError("Out-of-bag scoring is not available for this regression type.");
+		}
+
+		// a single fit on every example yields, as its diagnostics, a prediction for each example from a model that did
+		// not train on it; the modifiers are trained on every example though, so unlike k-fold scoring they see it
+		auto const fitStart = std::chrono::steady_clock::now();
+		std::tuple<typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...> modifierFunctions;
+		std::vector<T> heldOutValues;
+		TrainModifiersAndRegressor<RegressionType>(inputExamples,
+			targetExamples,
+			regressionOneShotTrainingParams,
+			heldOutValues,
+			0.0,
+			modifierOneShotTrainingParams,
+			modifierFunctions);
+		double const fitSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - fitStart).count();
+
+		dlib::running_stats<T> rs_abs;
+		dlib::running_stats<T> rs_sq;
+		dlib::running_scalar_covariance<T> rs_rc;
+		for (size_t i = 0; i < targetExamples.size(); ++i)
+		{
+			T const& result = heldOutValues[i];
+			T const& target = targetExamples[i];
+
+			T diff = result - target;
+			rs_abs.add(std::abs(diff));
+			rs_sq.add(diff * diff);
+			rs_rc.add(result, target);
+		}
+		report.Metrics = CrossValidationMetrics<T>(rs_abs, rs_sq, rs_rc);
+		report.FoldMetrics.assign(1, report.Metrics);
+		report.FoldSeconds.assign(1, fitSeconds);
+
+		return GetCrossValidationMetric(metric, report.Metrics);
+	}
 
+	template <typename T>
+	static T RegressorTrainer::GetCrossValidationMetric(ECrossValidationMetric const metric,
+		CrossValidationMetrics<T> const& metrics)
+	{
 		switch (metric)
 		{
 		case ECrossValidationMetric::SumSquareMax:
-			return rs_sq.max();
+			return metrics.SumSquareMax;
 		case ECrossValidationMetric::SumSquareMean:
-			return rs_sq.mean();
+			return metrics.SumSquareMean;
 		case ECrossValidationMetric::SumAbsoluteMax:
-			return rs_abs.max();
+			return metrics.SumAbsoluteMax;
 		case ECrossValidationMetric::SumAbsoluteMean:
-			return rs_abs.mean();
+			return metrics.SumAbsoluteMean;
 		case ECrossValidationMetric::CovarianceCorrelation:
-			return rs_rc.correlation();
+			return metrics.CovarianceCorrelation;
 		default:
 			throw RegressorError("Unrecognised cross-validation error metric.");
 		}
 	}
 
+	template <class RegressionType, class... ModifierOneShotParamsTypes>
+	static impl<RegressionType, typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainOnModifiedFold(IndexedVectorView<typename RegressionType::SampleType> const& foldTrainExamples,
+		IndexedVectorView<typename RegressionType::SampleType::type> const& foldTrainTargets,
+		typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+		std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams,
+		ModifiedFold<typename RegressionType::SampleType, typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...>& modifiedFold)
+	{
+		// the first regression parameter set to reach this fold trains the modifiers and transforms its examples; every
+		// other set waits for that to finish and then trains on the same transformed examples
+		std::call_once(modifiedFold.Prepared, [&]()
+			{
+				modifiedFold.Examples = foldTrainExamples.Materialise();
+				modifiedFold.Targets = foldTrainTargets.Materialise();
+				TrainModifiers<0>(modifiedFold.Examples, modifiedFold.Targets, modifierOneShotTrainingParams, modifiedFold.ModifierFunctions);
+				modifiedFold.IsPrepared = true;
+			});
+
+		std::vector<typename RegressionType::SampleType::type> additionalDiagnostics;
+		return RegressionType::Train(modifiedFold.Examples,
+			modifiedFold.Targets,
+			regressionOneShotTrainingParams,
+			additionalDiagnostics,
+			0.0,
+			modifiedFold.ModifierFunctions);
+	}
+
+	template <typename T>
+	static bool RegressorTrainer::IsOutOfRace(RaceState<T> const& race,
+		dlib::running_stats<T> const& completedFoldScores,
+		size_t const numFolds)
+	{
+		// every fold tests the same number of examples, so the mean error over all folds is the mean of the fold means
+		T const bestScore = race.BestScore;
+		switch (race.Rule)
+		{
+		case ERacingRule::Exact:
+			// the folds still to run can only add non-negative error
+			return completedFoldScores.mean() * completedFoldScores.current_n() / numFolds > bestScore;
+		case ERacingRule::LowerConfidenceBound:
+		{
+			if (completedFoldScores.current_n() < race.MinFolds)
+			{
+				return false;
+			}
+			T const standardError = completedFoldScores.current_n() > 1 ? completedFoldScores.stddev() / std::sqrt(completedFoldScores.current_n()) : 0.0;
+			return completedFoldScores.mean() - race.Confidence * standardError > bestScore;
+		}
+		default:
+			return false;
+		}
+	}
+
+	template <typename T>
+	static void RegressorTrainer::RecordRaceScore(RaceState<T>& race,
+		T const& score)
+	{
+		T bestScore = race.BestScore;
+		while (score < bestScore && !race.BestScore.compare_exchange_weak(bestScore, score))
+		{
+		}
+	}
+
+	template <typename T>
+	static void RegressorTrainer::CheckScoredBeforeStop(TrainingOptions<T> const& options,
+		T const& bestTrainingError)
+	{
+		// unscored parameter sets are reported as infinity, so an infinite best after a stop means none was scored
+		if (bestTrainingError == std::numeric_limits<T>::infinity() && options.IsStopRequested())
+		{
+			throw TrainingStoppedError("Training was stopped before any parameter set was scored.");
+		}
+	}
+
+	template <typename T>
+	static void RegressorTrainer::WriteReports(TrainingOptions<T> const& options,
+		std::vector<CrossValidationReport<T>> const& candidateReports,
+		size_t const bestIndex)
+	{
+		if (options.Report != nullptr)
+		{
+			*options.Report = candidateReports[bestIndex];
+		}
+		if (options.CandidateReports != nullptr)
+		{
+			*options.CandidateReports = candidateReports;
+		}
+	}
+
 	template <class RegressionType, class... ModifierOneShotTrainingTypes>
 	static impl<RegressionType, typename ModifierOneShotTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorOneShot(const std::vector<typename RegressionType::SampleType>& inputExamples,
 		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
@@ -105,11 +349,52 @@ namespace Regressors
 		typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
 		ModifierOneShotTrainingTypes const&... modifiersOneShotTrainingPack)
 	{
+		return TrainRegressorOneShot<RegressionType>(inputExamples, targetExamples, randomSeed, metric, numFolds, 1ull, diagnostics, regressionOneShotTrainingParams, modifiersOneShotTrainingPack...);
+	}
+
+	template <class RegressionType, class... ModifierOneShotTrainingTypes>
+	static impl<RegressionType, typename ModifierOneShotTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorOneShot(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		std::string const& randomSeed,
+		ECrossValidationMetric const metric,
+		size_t const numFolds,
+		size_t const numThreads,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+		ModifierOneShotTrainingTypes const&... modifiersOneShotTrainingPack)
+	{
+		FoldPlan const foldPlan(randomSeed, inputExamples.size(), numFolds);
+		TrainingOptions<typename RegressionType::SampleType::type> options;
+		options.NumThreads = numThreads;
+		return TrainRegressorOneShot<RegressionType>(inputExamples, targetExamples, foldPlan, metric, options, diagnostics, regressionOneShotTrainingParams, modifiersOneShotTrainingPack...);
+	}
+
+	template <class RegressionType, class... ModifierOneShotTrainingTypes>
+	static impl<RegressionType, typename ModifierOneShotTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorOneShot(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+		ModifierOneShotTrainingTypes const&... modifiersOneShotTrainingPack)
+	{
+		typedef typename RegressionType::SampleType::type T;
 		DLIB_ASSERT(dlib::is_learning_problem(inputExamples, targetExamples),
 			"Bad input data.");
 
 		std::tuple<ModifierOneShotTrainingTypes...> modifiersTrainingParams(modifiersOneShotTrainingPack...);
-		auto const trainingError = CrossValidate<RegressionType>(inputExamples, targetExamples, randomSeed, regressionOneShotTrainingParams, numFolds, metric, modifiersTrainingParams);
+		std::unique_ptr<dlib::thread_pool> ownedThreadPool;
+		dlib::thread_pool& tp = AcquireThreadPool(options, ownedThreadPool);
+		std::string const cacheContextKey = options.Cache ? GetCacheContextKey<RegressionType>(inputExamples, targetExamples, foldPlan, metric, options.Strategy) : std::string();
+		std::vector<CrossValidationReport<T>> reports(options.IsReportRequested() ? 1 : 0);
+		auto const trainingError = CrossValidateWithCache<RegressionType>(inputExamples, targetExamples, foldPlan, regressionOneShotTrainingParams, metric, modifiersTrainingParams, options, cacheContextKey, nullptr, nullptr, reports.empty() ? nullptr : &reports[0], tp);
+		if (options.NumCompletedEvaluations != nullptr)
+		{
+			*options.NumCompletedEvaluations = trainingError != std::numeric_limits<T>::infinity() ? 1 : 0;
+		}
+		CheckScoredBeforeStop(options, trainingError);
+		WriteReports(options, reports, 0);
 		std::tuple<typename ModifierOneShotTrainingTypes::ModifierType::ModifierFunction...> modifierFunctions;
 		return TrainModifiersAndRegressor<RegressionType>(inputExamples,
 			targetExamples,
@@ -120,38 +405,589 @@ namespace Regressors
 			modifierFunctions);
 	}
 
+	template <typename T>
+	static dlib::thread_pool& RegressorTrainer::AcquireThreadPool(TrainingOptions<T> const& options,
+		std::unique_ptr<dlib::thread_pool>& ownedThreadPool)
+	{
+		if (options.ThreadPool != nullptr)
+		{
+			return *options.ThreadPool;
+		}
+		ownedThreadPool.reset(new dlib::thread_pool(options.NumThreads));
+		return *ownedThreadPool;
+	}
+
+	template <class RegressionType, class TrainFunctionType>
+	static std::future<Regressor<typename RegressionType::SampleType>> RegressorTrainer::TrainAsync(TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		TrainFunctionType const& train)
+	{
+		typedef typename RegressionType::SampleType SampleType;
+
+		// the training runs on the pool it was queued on, so it never creates a pool of its own
+		dlib::thread_pool& tp = options.ThreadPool != nullptr ? *options.ThreadPool : dlib::default_thread_pool();
+		TrainingOptions<typename SampleType::type> taskOptions(options);
+		taskOptions.ThreadPool = &tp;
+
+		// queued through the pool's dispatcher, since adding a task to a busy pool directly would block the caller
+		auto const promise = std::make_shared<std::promise<Regressor<SampleType>>>();
+		TaskDispatcher::Submit(tp, [promise, taskOptions, train]()
+			{
+				try
+				{
+					promise->set_value(Regressor<SampleType>(train(taskOptions)));
+				}
+				catch (...)
+				{
+					promise->set_exception(std::current_exception());
+				}
+			});
+		return promise->get_future();
+	}
+
+	template <class RegressionType>
+	static std::string RegressorTrainer::GetCacheContextKey(std::vector<typename RegressionType::SampleType> const& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		ECrossValidationStrategy const strategy)
+	{
+		// computed once per training run and prefixed to every parameter key, so that results from different data,
+		// folds, metrics, strategies or regressor types can share a cache without colliding
+		std::ostringstream out;
+		dlib::serialize(inputExamples, out);
+		dlib::serialize(targetExamples, out);
+		dlib::serialize(foldPlan.GetNumFolds(), out);
+		dlib::serialize(foldPlan.GetShuffledIndices(), out);
+		dlib::serialize(static_cast<int>(metric), out);
+		dlib::serialize(static_cast<int>(strategy), out);
+		serialize(RegressionType::RegressorTypeEnum, out);
+		return dlib::md5(out.str());
+	}
+
+	template <class RegressionType, class... ModifierOneShotParamsTypes>
+	static typename RegressionType::SampleType::type RegressorTrainer::CrossValidateWithCache(std::vector<typename RegressionType::SampleType> const& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+		ECrossValidationMetric const metric,
+		std::tuple<ModifierOneShotParamsTypes...> const& modifierOneShotTrainingParams,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::string const& cacheContextKey,
+		ModifiedFold<typename RegressionType::SampleType, typename ModifierOneShotParamsTypes::ModifierType::ModifierFunction...>* const modifiedFolds,
+		RaceState<typename RegressionType::SampleType::type>* const race,
+		CrossValidationReport<typename RegressionType::SampleType::type>* const report,
+		dlib::thread_pool& tp)
+	{
+		typedef typename RegressionType::SampleType::type T;
+
+		CrossValidationReport<T> localReport;
+		CrossValidationReport<T>& scoreReport = report != nullptr ? *report : localReport;
+		auto const score = [&]()
+		{
+			if (options.IsStopRequested())
+			{
+				return std::numeric_limits<T>::infinity();
+			}
+			if (options.Strategy != ECrossValidationStrategy::KFold)
+			{
+				MemoryAdmission const admission(options.TaskMemoryBudget, options.TaskMemoryBudget != nullptr ?
+					RegressionType::EstimatePeakMemory(regressionOneShotTrainingParams, inputExamples.size(), inputExamples.empty() ? 0 : static_cast<size_t>(inputExamples[0].size())) :
+					0);
+				return ScoreSingleFit<RegressionType>(inputExamples, targetExamples, regressionOneShotTrainingParams, metric, options.Strategy, modifierOneShotTrainingParams, scoreReport);
+			}
+			return CrossValidate<RegressionType>(inputExamples, targetExamples, foldPlan, regressionOneShotTrainingParams, metric, modifierOneShotTrainingParams, options, modifiedFolds, race, scoreReport, tp);
+		};
+
+		T result;
+		if (options.Cache == nullptr)
+		{
+			result = score();
+		}
+		else
+		{
+			std::ostringstream key;
+			key << cacheContextKey;
+			RegressionType::SerializeCacheKey(regressionOneShotTrainingParams, key);
+			dlib::serialize(modifierOneShotTrainingParams, key);
+
+			// the report is stored with the result, so a cached parameter set reports what its first scoring measured
+			if (!options.Cache->Find(key.str(), result, &scoreReport))
+			{
+				result = score();
+				// racing and stopping leave a parameter set unscored, which is reported as infinity and never cached
+				if (result != std::numeric_limits<T>::infinity())
+				{
+					options.Cache->Insert(key.str(), result, scoreReport);
+				}
+			}
+		}
+
+		if (race != nullptr)
+		{
+			RecordRaceScore(*race, result);
+		}
+		return result;
+	}
+
 	template <class RegressionType, class... ModifierOneShotTrainingTypes>
 	static void RegressorTrainer::CrossValidateTrainingParameterSets(std::vector<typename RegressionType::SampleType> const& inputExamples,
 			std::vector<typename RegressionType::SampleType::type> const& targetExamples,
-			std::string const& randomSeed,
+			FoldPlan const& foldPlan,
 			std::vector<typename RegressionType::OneShotTrainingParams> const& regressionTrainingParamsToTry,
 			std::vector<std::tuple<ModifierOneShotTrainingTypes...>>& modifierTrainingParamsToTry,
-			size_t const numFolds,
 			ECrossValidationMetric const metric,
 			std::vector<std::pair<std::pair<size_t, size_t>, typename RegressionType::SampleType::type>>& regressionModifierParamsTrainingError,
+			std::vector<CrossValidationReport<typename RegressionType::SampleType::type>>& candidateReports,
+			TrainingOptions<typename RegressionType::SampleType::type> const& options,
+			std::string const& cacheContextKey,
 			dlib::thread_pool& tp)
 	{
+		typedef typename RegressionType::SampleType SampleType;
 		typedef typename RegressionType::SampleType::type T;
 
+		// modifiers do not depend on the regression parameters, so each is trained once per fold and shared by every
+		// regression parameter set that it is paired with
+		size_t const numFolds = foldPlan.GetNumFolds();
+		std::vector<ModifiedFold<SampleType, typename ModifierOneShotTrainingTypes::ModifierType::ModifierFunction...>> modifiedFolds(sizeof...(ModifierOneShotTrainingTypes) > 0 ? modifierTrainingParamsToTry.size() * numFolds : 0);
+		// parameter sets are queued one modifier set after another and each modifier set's folds are released as soon as the
+		// last regression parameter set paired with it has been scored, so only the modifier sets in flight hold their folds
+		std::vector<std::atomic<size_t>> numUnscoredParameterSets(modifiedFolds.empty() ? 0 : modifierTrainingParamsToTry.size());
+		for (auto& numUnscored : numUnscoredParameterSets)
+		{
+			numUnscored = regressionTrainingParamsToTry.size();
+		}
+		std::atomic<size_t> numModifierTrainings(0);
+
+		// racing relies on the mean error over all folds being the mean of the per-fold errors
+		RaceState<T> race;
+		race.Rule = metric == ECrossValidationMetric::SumSquareMean || metric == ECrossValidationMetric::SumAbsoluteMean ? options.Racing : ERacingRule::Off;
+		race.Confidence = options.RacingConfidence;
+		race.MinFolds = options.RacingMinFolds;
+		race.BestScore = std::numeric_limits<T>::infinity();
+		race.NumPruned = 0;
+
 		regressionModifierParamsTrainingError.resize(regressionTrainingParamsToTry.size() * modifierTrainingParamsToTry.size());
-		for (size_t i = 0; i < regressionModifierParamsTrainingError.size(); ++i)
+		// each parameter set's report is collected as it is scored, so the selected set's report needs no second run
+		candidateReports.assign(options.IsReportRequested() ? regressionModifierParamsTrainingError.size() : 0, CrossValidationReport<T>());
+		// the pool may be shared with other training runs, so only this grid's tasks are waited for
+		std::vector<dlib::uint64> parameterSetTaskIds(regressionModifierParamsTrainingError.size());
+		for (size_t index = 0; index < regressionModifierParamsTrainingError.size(); ++index)
 		{
-			tp.add_task_by_value([&](size_t index)
+			parameterSetTaskIds[index] = tp.add_task_by_value([&, index]()
 				{
 					size_t regressionParamsIndex = index % regressionTrainingParamsToTry.size();
 					size_t modifiersParamsIndex = index / regressionTrainingParamsToTry.size();
 					regressionModifierParamsTrainingError[index].first.first = regressionParamsIndex;
 					regressionModifierParamsTrainingError[index].first.second = modifiersParamsIndex;
-					regressionModifierParamsTrainingError[index].second = RegressorTrainer::template CrossValidate<RegressionType>(inputExamples,
+					regressionModifierParamsTrainingError[index].second = RegressorTrainer::template CrossValidateWithCache<RegressionType>(inputExamples,
 						targetExamples,
-						randomSeed,
+						foldPlan,
 						regressionTrainingParamsToTry[regressionParamsIndex],
-						numFolds,
 						metric,
-						modifierTrainingParamsToTry[modifiersParamsIndex]);
-				}, dlib::future<size_t>(i));
+						modifierTrainingParamsToTry[modifiersParamsIndex],
+						options,
+						cacheContextKey,
+						modifiedFolds.empty() ? nullptr : &modifiedFolds[modifiersParamsIndex * numFolds],
+						race.Rule == ERacingRule::Off ? nullptr : &race,
+						candidateReports.empty() ? nullptr : &candidateReports[index],
+						tp);
+					if (!modifiedFolds.empty() && --numUnscoredParameterSets[modifiersParamsIndex] == 0)
+					{
+						for (size_t fold = 0; fold < numFolds; ++fold)
+						{
+							auto& modifiedFold = modifiedFolds[modifiersParamsIndex * numFolds + fold];
+							if (modifiedFold.IsPrepared)
+							{
+								++numModifierTrainings;
+							}
+							modifiedFold.ModifierFunctions = decltype(modifiedFold.ModifierFunctions)();
+							std::vector<SampleType>().swap(modifiedFold.Examples);
+							std::vector<T>().swap(modifiedFold.Targets);
+						}
+					}
+				});
+		}
+		for (auto const taskId : parameterSetTaskIds)
+		{
+			tp.wait_for_task(taskId);
+		}
+
+		if (options.NumPrunedEvaluations != nullptr)
+		{
+			*options.NumPrunedEvaluations = race.NumPruned;
+		}
+		if (options.NumModifierTrainings != nullptr)
+		{
+			*options.NumModifierTrainings = numModifierTrainings;
+		}
+	}
+
+	template <class RegressionType, class... ModifierOneShotTrainingTypes>
+	static void RegressorTrainer::CrossValidateCandidates(std::vector<typename RegressionType::SampleType> const& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		std::vector<typename RegressionType::OneShotTrainingParams> const& regressionTrainingParamsToTry,
+		std::vector<std::tuple<ModifierOneShotTrainingTypes...>> const& modifierTrainingParamsToTry,
+		std::vector<std::pair<size_t, size_t>> const& candidates,
+		ECrossValidationMetric const metric,
+		std::vector<typename RegressionType::SampleType::type>& candidateTrainingErrors,
+		std::vector<CrossValidationReport<typename RegressionType::SampleType::type>>& candidateReports,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::string const& cacheContextKey,
+		dlib::thread_pool& tp)
+	{
+		candidateTrainingErrors.resize(candidates.size());
+		candidateReports.assign(options.IsReportRequested() ? candidates.size() : 0, CrossValidationReport<typename RegressionType::SampleType::type>());
+		std::vector<dlib::uint64> candidateTaskIds(candidates.size());
+		for (size_t i = 0; i < candidates.size(); ++i)
+		{
+			candidateTaskIds[i] = tp.add_task_by_value([&, i]()
+				{
+					candidateTrainingErrors[i] = CrossValidateWithCache<RegressionType>(inputExamples,
+						targetExamples,
+						foldPlan,
+						regressionTrainingParamsToTry[candidates[i].first],
+						metric,
+						modifierTrainingParamsToTry[candidates[i].second],
+						options,
+						cacheContextKey,
+						nullptr,
+						nullptr,
+						candidateReports.empty() ? nullptr : &candidateReports[i],
+						tp);
+				});
+		}
+		for (auto const taskId : candidateTaskIds)
+		{
+			tp.wait_for_task(taskId);
+		}
+	}
+
+	inline std::vector<std::pair<size_t, size_t>> RegressorTrainer::SampleCandidates(size_t const numRegressionParams,
+		size_t const numModifierParams,
+		std::vector<size_t> const& regressionNumValuesPerAxis,
+		std::vector<size_t> const& modifierNumValuesPerAxis,
+		size_t const numSamples,
+		RandomStream stream)
+	{
+		std::vector<std::pair<size_t, size_t>> candidates;
+		if (numSamples >= numRegressionParams * numModifierParams)
+		{
+			for (size_t m = 0; m < numModifierParams; ++m)
+			{
+				for (size_t r = 0; r < numRegressionParams; ++r)
+				{
+					candidates.emplace_back(r, m);
+				}
+			}
+			return candidates;
+		}
+
+		// each sample takes one of numSamples equal strata of every axis, with the strata of each axis shuffled
+		// independently. An axis with no more values than samples maps its strata evenly onto its values so that every
+		// value is taken; a longer axis draws a uniform position within the stratum.
+		auto const sampleAxes = [&](std::vector<size_t> const& numValuesPerAxis)
+		{
+			std::vector<size_t> indices(numSamples, 0);
+			std::vector<size_t> strata(numSamples);
+			for (size_t const numValues : numValuesPerAxis)
+			{
+				std::iota(strata.begin(), strata.end(), 0);
+				for (size_t i = numSamples; i > 1; --i)
+				{
+					std::swap(strata[i - 1], strata[stream.GetRandomIndex(i)]);
+				}
+				for (size_t s = 0; s < numSamples; ++s)
+				{
+					size_t value;
+					if (numSamples >= numValues)
+					{
+						value = strata[s] * numValues / numSamples;
+					}
+					else
+					{
+						value = static_cast<size_t>((static_cast<double>(strata[s]) + stream.GetRandomDouble()) * static_cast<double>(numValues) / static_cast<double>(numSamples));
+						value = std::min(value, numValues - 1);
+					}
+					// the grid nests the axes in order, so the last one varies fastest
+					indices[s] = indices[s] * numValues + value;
+				}
+			}
+			return indices;
+		};
+
+		std::vector<size_t> const regressionIndices = sampleAxes(regressionNumValuesPerAxis);
+		std::vector<size_t> const modifierIndices = sampleAxes(modifierNumValuesPerAxis);
+		candidates.reserve(numSamples);
+		for (size_t s = 0; s < numSamples; ++s)
+		{
+			candidates.emplace_back(regressionIndices[s], modifierIndices[s]);
+		}
+
+		auto const gridOrder = [](std::pair<size_t, size_t> const& a, std::pair<size_t, size_t> const& b)
+		{
+			return std::make_pair(a.second, a.first) < std::make_pair(b.second, b.first);
+		};
+		std::sort(candidates.begin(), candidates.end(), gridOrder);
+		candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+		// samples that share a grid point leave the budget short; it is topped up with distinct points drawn uniformly
+		// from the rest of the grid, which is larger than the budget here so the draws terminate
+		std::vector<std::pair<size_t, size_t>> topUp;
+		while (candidates.size() + topUp.size() < numSamples)
+		{
+			std::pair<size_t, size_t> const candidate(stream.GetRandomIndex(numRegressionParams), stream.GetRandomIndex(numModifierParams));
+			if (!std::binary_search(candidates.begin(), candidates.end(), candidate, gridOrder)
+				&& std::find(topUp.begin(), topUp.end(), candidate) == topUp.end())
+			{
+				topUp.push_back(candidate);
+			}
+		}
+		candidates.insert(candidates.end(), topUp.begin(), topUp.end());
+		std::sort(candidates.begin(), candidates.end(), gridOrder);
+		return candidates;
+	}
+
+	template <typename T, class ObjectiveFunctionType>
+	static dlib::function_evaluation RegressorTrainer::FindMinGlobal(ObjectiveFunctionType const& objective,
+		col_vector<T> const& lowerBound,
+		col_vector<T> const& upperBound,
+		std::vector<bool> const& isIntegerParam,
+		size_t const maxNumCalls,
+		T const& optimisationTolerance,
+		TrainingOptions<T> const& options,
+		std::string const& checkpointFingerprint,
+		dlib::thread_pool& tp)
+	{
+		// This follows dlib::find_min_global, except that candidates are requested in batches and their results are
+		// reported back in request order. dlib's threaded overload reports results as they complete, which makes the
+		// search depend on timing; batching keeps a run reproducible for a given batch size, and a batch size of one
+		// reproduces dlib's serial search exactly.
+		size_t const batchSize = options.NumConcurrentEvaluations;
+		DLIB_ASSERT(batchSize > 0,
+			"Input parameter batchSize must be greater than zero.");
+		// evaluations are kept as dlib reports them, negated for maximisation, so that a checkpoint can seed the optimiser
+		std::vector<dlib::function_evaluation> evaluations;
+		if (!options.CheckpointPath.empty())
+		{
+			LoadCheckpoint(options.CheckpointPath, checkpointFingerprint, evaluations);
+		}
+
+		dlib::function_spec const spec(dlib::matrix_cast<double>(lowerBound), dlib::matrix_cast<double>(upperBound), isIntegerParam);
+		std::unique_ptr<dlib::global_function_search> const optimiser(evaluations.empty() ?
+			new dlib::global_function_search(spec) :
+			new dlib::global_function_search(std::vector<dlib::function_spec>(1, spec), std::vector<std::vector<dlib::function_evaluation>>(1, evaluations)));
+		optimiser->set_solver_epsilon(optimisationTolerance);
+
+		std::vector<dlib::function_evaluation_request> requests;
+		std::vector<T> values;
+		std::vector<std::vector<T>> pointFidelityScores;
+		std::vector<char> pointPruned;
+		std::vector<CrossValidationReport<T>> pointReports;
+		std::vector<std::exception_ptr> errors;
+		std::vector<dlib::uint64> taskIds;
+		size_t numEvaluations = evaluations.size();
+		// the sorted scores of every point on each lower fidelity from the batches before the current one, which the
+		// objective may use to decide how much effort a point deserves without depending on the order in which the batch
+		// completes
+		std::vector<std::vector<T>> fidelityScores;
+		// the reports of the points scored on the full data by this run, in request order, and the points themselves
+		std::vector<CrossValidationReport<T>> reports;
+		std::vector<dlib::matrix<double, 0, 1>> reportPoints;
+		// points left on a lower fidelity are reported to the optimiser as the worst full-data score so far, which steers it
+		// away from them without claiming a score they were never given; they are kept out of the checkpoint and never
+		// selected, and while no full-data score exists they are neither reported nor charged against maxNumCalls
+		T worstFullDataScore = -std::numeric_limits<T>::infinity();
+		for (auto const& evaluation : evaluations)
+		{
+			worstFullDataScore = std::max(worstFullDataScore, static_cast<T>(-evaluation.y));
+		}
+		size_t numCharged = 0;
+		for (size_t numCalls = evaluations.size(); numCalls < maxNumCalls && !options.IsStopRequested(); numCalls += numCharged)
+		{
+			requests.clear();
+			for (size_t i = 0; i < batchSize && numCalls + i < maxNumCalls; ++i)
+			{
+				requests.emplace_back(optimiser->get_next_x());
+			}
+
+			values.assign(requests.size(), T(0));
+			pointFidelityScores.assign(requests.size(), std::vector<T>());
+			pointPruned.assign(requests.size(), 0);
+			pointReports.assign(options.IsReportRequested() ? requests.size() : 0, CrossValidationReport<T>());
+			errors.assign(requests.size(), nullptr);
+			taskIds.resize(requests.size());
+			for (size_t i = 0; i < requests.size(); ++i)
+			{
+				taskIds[i] = tp.add_task_by_value([&, i]()
+					{
+						try
+						{
+							col_vector<T> const params = dlib::matrix_cast<T>(requests[i].x());
+							bool isPruned = false;
+							values[i] = objective(params, fidelityScores, pointFidelityScores[i], isPruned, pointReports.empty() ? nullptr : &pointReports[i]);
+							pointPruned[i] = isPruned;
+						}
+						catch (...)
+						{
+							errors[i] = std::current_exception();
+						}
+					});
+			}
+			for (auto const taskId : taskIds)
+			{
+				tp.wait_for_task(taskId);
+			}
+
+			numCharged = 0;
+			for (size_t i = 0; i < requests.size(); ++i)
+			{
+				if (errors[i])
+				{
+					std::rethrow_exception(errors[i]);
+				}
+				// a point whose cross-validation was stopped is left unevaluated, since the optimiser would take any score it
+				// was given for a full-data one
+				if (values[i] != std::numeric_limits<T>::infinity())
+				{
+					requests[i].set(-values[i]);
+					evaluations.emplace_back(requests[i].x(), -values[i]);
+					worstFullDataScore = std::max(worstFullDataScore, values[i]);
+					++numEvaluations;
+					++numCharged;
+					if (!pointReports.empty())
+					{
+						reports.push_back(pointReports[i]);
+						reportPoints.push_back(requests[i].x());
+					}
+				}
+				else if (pointPruned[i])
+				{
+					// full-data scores are taken in request order, so the value does not depend on the order points complete in
+					if (worstFullDataScore != -std::numeric_limits<T>::infinity())
+					{
+						requests[i].set(-worstFullDataScore);
+						++numCharged;
+					}
+				}
+				else
+				{
+					++numCharged;
+				}
+				for (size_t fidelity = 0; fidelity < pointFidelityScores[i].size(); ++fidelity)
+				{
+					if (fidelityScores.size() <= fidelity)
+					{
+						fidelityScores.resize(fidelity + 1);
+					}
+					std::vector<T>& scores = fidelityScores[fidelity];
+					scores.insert(std::upper_bound(scores.begin(), scores.end(), pointFidelityScores[i][fidelity]), pointFidelityScores[i][fidelity]);
+				}
+			}
+
+			if (!options.CheckpointPath.empty())
+			{
+				SaveCheckpoint(options.CheckpointPath, checkpointFingerprint, evaluations);
+			}
+		}
+
+		if (numEvaluations == 0)
+		{
+			CheckScoredBeforeStop(options, std::numeric_limits<T>::infinity());
+			throw RegressorError("No point was evaluated by the find_min_global search.");
+		}
+
+		// the best of the full-data scores, which the pessimistic values of pruned points can only tie
+		auto const bestEvaluation = std::max_element(evaluations.begin(), evaluations.end(), [](dlib::function_evaluation const& a, dlib::function_evaluation const& b)
+			{
+				return a.y < b.y;
+			});
+		dlib::matrix<double, 0, 1> const x = bestEvaluation->x;
+		double const y = bestEvaluation->y;
+
+		// the best point's report was collected when it was scored, unless it was reloaded from a checkpoint
+		if (options.Report != nullptr)
+		{
+			auto const bestReportPoint = std::find(reportPoints.begin(), reportPoints.end(), x);
+			*options.Report = bestReportPoint != reportPoints.end() ? reports[bestReportPoint - reportPoints.begin()] : CrossValidationReport<T>();
+		}
+		if (options.CandidateReports != nullptr)
+		{
+			*options.CandidateReports = reports;
+		}
+		return dlib::function_evaluation(x, -y);
+	}
+
+	inline void RegressorTrainer::LoadCheckpoint(std::string const& checkpointPath,
+		std::string const& checkpointFingerprint,
+		std::vector<dlib::function_evaluation>& evaluations)
+	{
+		evaluations.clear();
+		std::ifstream in(checkpointPath, std::ios::binary);
+		if (!in)
+		{
+			return;
+		}
+
+		// a checkpoint of a different search, or one that cannot be read, is ignored and later overwritten
+		try
+		{
+			std::string fingerprint;
+			dlib::deserialize(fingerprint, in);
+			if (fingerprint != checkpointFingerprint)
+			{
+				return;
+			}
+
+			// the count is not trusted to size the vector, since a corrupt one could ask for any amount of memory; a count
+			// larger than the file holds fails on the first missing evaluation instead
+			size_t numEvaluations;
+			dlib::deserialize(numEvaluations, in);
+			for (size_t e = 0; e < numEvaluations; ++e)
+			{
+				dlib::function_evaluation evaluation;
+				dlib::deserialize(evaluation.x, in);
+				dlib::deserialize(evaluation.y, in);
+				evaluations.push_back(std::move(evaluation));
+			}
+		}
+		catch (std::exception const&)
+		{
+			// corrupt lengths inside the file surface as std::bad_alloc or std::length_error rather than as
+			// dlib::serialization_error
+			evaluations.clear();
+		}
+	}
+
+	inline void RegressorTrainer::SaveCheckpoint(std::string const& checkpointPath,
+		std::string const& checkpointFingerprint,
+		std::vector<dlib::function_evaluation> const& evaluations)
+	{
+		// the checkpoint is written beside the old one and then renamed over it, which replaces it in one step (rename(2)
+		// on POSIX, MoveFileEx with MOVEFILE_REPLACE_EXISTING on Windows), so that a process killed at any point leaves
+		// either the previous checkpoint or the new one
+		std::string const partialPath = checkpointPath + ".partial";
+		{
+			std::ofstream out(partialPath, std::ios::binary | std::ios::trunc);
+			dlib::serialize(checkpointFingerprint, out);
+			dlib::serialize(evaluations.size(), out);
+			for (auto const& evaluation : evaluations)
+			{
+				dlib::serialize(evaluation.x, out);
+				dlib::serialize(evaluation.y, out);
+			}
+			out.close();
+			if (!out)
+			{
+				throw RegressorError("Unable to write checkpoint file " + partialPath + ".");
+			}
+		}
+		std::error_code error;
+		std::filesystem::rename(partialPath, checkpointPath, error);
+		if (error)
+		{
+			throw RegressorError("Unable to replace checkpoint file " + checkpointPath + ": " + error.message() + ".");
 		}
-		tp.wait_for_all_tasks();
 	}
 
 	template <size_t I, class... ModifierFindMinGlobalTrainingTypes>
@@ -166,50 +1002,338 @@ namespace Regressors
 			using ModifierType = typename std::tuple_element<I, std::tuple<ModifierFindMinGlobalTrainingTypes...>>::type::ModifierType;
 			return ModifierType::NumModifierParams + GetNumModifierParams<I + 1, ModifierFindMinGlobalTrainingTypes...>();
 		}
-	}
+	}
+
+	template <class RegressionType, class SampleContainerType, class TargetContainerType, class... ModifierOneShotTrainingParamsTypes>
+	static impl<RegressionType, typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainModifiersAndRegressor(SampleContainerType const& inputExamples,
+		TargetContainerType const& targetExamples,
+		typename RegressionType::OneShotTrainingParams const& regressionParams,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::SampleType::type const& trainingError,
+		std::tuple<ModifierOneShotTrainingParamsTypes...> const& modifierOneShotParams,
+		std::tuple<typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...>& modifierFunctions)
+	{
+		if constexpr (sizeof...(ModifierOneShotTrainingParamsTypes) == 0)
+		{
+			return RegressionType::Train(inputExamples,
+				targetExamples,
+				regressionParams,
+				diagnostics,
+				trainingError,
+				modifierFunctions);
+		}
+		else
+		{
+			// modifiers rewrite every example, so the examples are copied once here and each modifier is then applied in place
+			std::vector<typename RegressionType::SampleType> examples(AsStdVector(inputExamples));
+			auto const& targets = AsStdVector(targetExamples);
+			TrainModifiers<0>(examples, targets, modifierOneShotParams, modifierFunctions);
+			return RegressionType::Train(examples,
+				targets,
+				regressionParams,
+				diagnostics,
+				trainingError,
+				modifierFunctions);
+		}
+	}
+
+	template <size_t I, typename SampleType, class... ModifierOneShotTrainingParamsTypes>
+	static void RegressorTrainer::TrainModifiers(std::vector<SampleType>& examples,
+		std::vector<typename SampleType::type> const& targetExamples,
+		std::tuple<ModifierOneShotTrainingParamsTypes...> const& modifierOneShotParams,
+		std::tuple<typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...>& modifierFunctions)
+	{
+		if constexpr (I == sizeof...(ModifierOneShotTrainingParamsTypes))
+		{
+			return;
+		}
+		else
+		{
+			using ModifierType = typename std::tuple_element<I, std::tuple<ModifierOneShotTrainingParamsTypes...>>::type::ModifierType;
+			auto& modifier = std::get<I>(modifierFunctions);
+			auto const& params = std::get<I>(modifierOneShotParams);
+			ModifierType::TrainModifier(modifier, params, examples, targetExamples);
+			for (auto& example : examples)
+			{
+				modifier(example);
+			}
+			TrainModifiers<I + 1>(examples, targetExamples, modifierOneShotParams, modifierFunctions);
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <class RegressionType, class...ModifierCrossValidationTrainingTypes>
+	static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorCrossValidation(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		std::string const& randomSeed,
+		ECrossValidationMetric const metric,
+		size_t const numFolds,
+		size_t const numThreads,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+		ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack)
+	{
+		FoldPlan const foldPlan(randomSeed, inputExamples.size(), numFolds);
+		TrainingOptions<typename RegressionType::SampleType::type> options;
+		options.NumThreads = numThreads;
+		return TrainRegressorCrossValidation<RegressionType>(inputExamples, targetExamples, foldPlan, metric, options, diagnostics, regressionCrossValidationTrainingParams, modifiersCrossValidationTrainingPack...);
+	}
+
+	template <class RegressionType, class...ModifierCrossValidationTrainingTypes>
+	static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorCrossValidation(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+		ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack)
+	{
+		typedef typename RegressionType::SampleType::type T;
+		DLIB_ASSERT(dlib::is_learning_problem(inputExamples, targetExamples),
+			"Bad input data.");
+
+		std::tuple<ModifierCrossValidationTrainingTypes...> modifierCrossValidationParams(modifiersCrossValidationTrainingPack...);
+		
+		std::vector<typename RegressionType::OneShotTrainingParams> regressionParamsToTry;
+		RegressionType::IterateRegressionParams(regressionCrossValidationTrainingParams, regressionParamsToTry);
+		
+		std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>> modifierParamsToTry;
+		IterateModifiers(modifierCrossValidationParams, modifierParamsToTry);
+
+		std::unique_ptr<dlib::thread_pool> ownedThreadPool;
+		dlib::thread_pool& tp = AcquireThreadPool(options, ownedThreadPool);
+		std::string const cacheContextKey = options.Cache ? GetCacheContextKey<RegressionType>(inputExamples, targetExamples, foldPlan, metric, options.Strategy) : std::string();
+		std::vector<std::pair<std::pair<size_t, size_t>, T>> regressorModifierParamsIndexTrainingError;
+		std::vector<CrossValidationReport<T>> candidateReports;
+
+		CrossValidateTrainingParameterSets<RegressionType>(inputExamples, targetExamples, foldPlan, regressionParamsToTry, modifierParamsToTry, metric, regressorModifierParamsIndexTrainingError, candidateReports, options, cacheContextKey, tp);
+		if (options.NumCompletedEvaluations != nullptr)
+		{
+			*options.NumCompletedEvaluations = std::count_if(regressorModifierParamsIndexTrainingError.begin(), regressorModifierParamsIndexTrainingError.end(), [](std::pair<std::pair<size_t, size_t>, T> const& trainingError)
+				{
+					return trainingError.second != std::numeric_limits<T>::infinity();
+				});
+		}
+		size_t bestIndex = 0;
+		for (size_t i = 0; i < regressorModifierParamsIndexTrainingError.size(); ++i)
+		{
+			if (regressorModifierParamsIndexTrainingError[i].second < regressorModifierParamsIndexTrainingError[bestIndex].second)
+			{
+				bestIndex = i;
+			}
+		}
+		CheckScoredBeforeStop(options, regressorModifierParamsIndexTrainingError[bestIndex].second);
+		WriteReports(options, candidateReports, bestIndex);
+		std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> modifierFunctions;
+		return TrainModifiersAndRegressor<RegressionType>(inputExamples,
+			targetExamples,
+			regressionParamsToTry[regressorModifierParamsIndexTrainingError[bestIndex].first.first],
+			diagnostics,
+			regressorModifierParamsIndexTrainingError[bestIndex].second,
+			modifierParamsToTry[regressorModifierParamsIndexTrainingError[bestIndex].first.second],
+			modifierFunctions);
+	}
+
+	template <class RegressionType, class...ModifierCrossValidationTrainingTypes>
+	static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorSuccessiveHalving(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		std::string const& randomSeed,
+		ECrossValidationMetric const metric,
+		size_t const numFolds,
+		size_t const numThreads,
+		size_t const reductionFactor,
+		size_t const minNumExamples,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+		ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack)
+	{
+		FoldPlan const foldPlan(randomSeed, inputExamples.size(), numFolds);
+		TrainingOptions<typename RegressionType::SampleType::type> options;
+		options.NumThreads = numThreads;
+		return TrainRegressorSuccessiveHalving<RegressionType>(inputExamples, targetExamples, foldPlan, metric, reductionFactor, minNumExamples, options, diagnostics, regressionCrossValidationTrainingParams, modifiersCrossValidationTrainingPack...);
+	}
+
+	template <class RegressionType, class...ModifierCrossValidationTrainingTypes>
+	static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorSuccessiveHalving(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		size_t const reductionFactor,
+		size_t const minNumExamples,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+		ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack)
+	{
+		typedef typename RegressionType::SampleType SampleType;
+		typedef typename RegressionType::SampleType::type T;
+		DLIB_ASSERT(dlib::is_learning_problem(inputExamples, targetExamples),
+			"Bad input data.");
+		DLIB_ASSERT(reductionFactor > 1,
+			"Input parameter reductionFactor must be greater than one.");
+		DLIB_ASSERT(minNumExamples > foldPlan.GetNumFolds(),
+			"Input parameter minNumExamples must be greater than the number of folds.");
+
+		std::tuple<ModifierCrossValidationTrainingTypes...> modifierCrossValidationParams(modifiersCrossValidationTrainingPack...);
+
+		std::vector<typename RegressionType::OneShotTrainingParams> regressionParamsToTry;
+		RegressionType::IterateRegressionParams(regressionCrossValidationTrainingParams, regressionParamsToTry);
+
+		std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>> modifierParamsToTry;
+		IterateModifiers(modifierCrossValidationParams, modifierParamsToTry);
+
+		// candidates are (regression parameters index, modifier parameters index) pairs, kept in grid order throughout
+		std::vector<std::pair<size_t, size_t>> candidates;
+		candidates.reserve(regressionParamsToTry.size() * modifierParamsToTry.size());
+		for (size_t m = 0; m < modifierParamsToTry.size(); ++m)
+		{
+			for (size_t r = 0; r < regressionParamsToTry.size(); ++r)
+			{
+				candidates.emplace_back(r, m);
+			}
+		}
+
+		// the number of examples used on each rung, smallest first and ending with the full training set
+		std::vector<size_t> rungNumExamples(1, inputExamples.size());
+		while (rungNumExamples.back() / reductionFactor >= minNumExamples)
+		{
+			rungNumExamples.push_back(rungNumExamples.back() / reductionFactor);
+		}
+		std::reverse(rungNumExamples.begin(), rungNumExamples.end());
+
+		std::unique_ptr<dlib::thread_pool> ownedThreadPool;
+		dlib::thread_pool& tp = AcquireThreadPool(options, ownedThreadPool);
+		std::vector<T> candidateTrainingErrors;
+		std::vector<CrossValidationReport<T>> candidateReports;
+		size_t numCompletedEvaluations = 0;
+		auto const isCompleted = [](T const& trainingError)
+		{
+			return trainingError != std::numeric_limits<T>::infinity();
+		};
+		// the best candidate of the largest rung that scored any, which a run stopped before the full training set returns
+		std::pair<size_t, size_t> stoppedCandidate;
+		T stoppedTrainingError = std::numeric_limits<T>::infinity();
+		CrossValidationReport<T> stoppedReport;
+		for (size_t rung = 0; rung + 1 < rungNumExamples.size() && candidates.size() > 1; ++rung)
+		{
+			// a prefix of the shuffled examples is itself a random subsample, so it is cross-validated in that order
+			size_t const numRungExamples = rungNumExamples[rung];
+			std::vector<SampleType> rungInputExamples;
+			std::vector<T> rungTargetExamples;
+			rungInputExamples.reserve(numRungExamples);
+			rungTargetExamples.reserve(numRungExamples);
+			for (size_t i = 0; i < numRungExamples; ++i)
+			{
+				size_t const index = foldPlan.GetShuffledIndices()[i];
+				rungInputExamples.push_back(inputExamples[index]);
+				rungTargetExamples.push_back(targetExamples[index]);
+			}
+			std::vector<size_t> rungOrder(numRungExamples);
+			std::iota(rungOrder.begin(), rungOrder.end(), 0);
+			FoldPlan const rungFoldPlan(rungOrder, foldPlan.GetNumFolds());
+
+			std::string const cacheContextKey = options.Cache ? GetCacheContextKey<RegressionType>(rungInputExamples, rungTargetExamples, rungFoldPlan, metric, options.Strategy) : std::string();
+			CrossValidateCandidates<RegressionType>(rungInputExamples, rungTargetExamples, rungFoldPlan, regressionParamsToTry, modifierParamsToTry, candidates, metric, candidateTrainingErrors, candidateReports, options, cacheContextKey, tp);
+			numCompletedEvaluations += std::count_if(candidateTrainingErrors.begin(), candidateTrainingErrors.end(), isCompleted);
+			auto const rungBest = std::min_element(candidateTrainingErrors.begin(), candidateTrainingErrors.end());
+			if (isCompleted(*rungBest))
+			{
+				stoppedCandidate = candidates[rungBest - candidateTrainingErrors.begin()];
+				stoppedTrainingError = *rungBest;
+				stoppedReport = candidateReports[rungBest - candidateTrainingErrors.begin()];
+			}
+
+			std::vector<size_t> survivors(candidates.size());
+			std::iota(survivors.begin(), survivors.end(), 0);
+			std::stable_sort(survivors.begin(), survivors.end(), [&](size_t const a, size_t const b)
+				{
+					return candidateTrainingErrors[a] < candidateTrainingErrors[b];
+				});
+			survivors.resize((candidates.size() + reductionFactor - 1) / reductionFactor);
+			std::sort(survivors.begin(), survivors.end());
+
+			std::vector<std::pair<size_t, size_t>> survivingCandidates;
+			survivingCandidates.reserve(survivors.size());
+			for (auto const survivor : survivors)
+			{
+				survivingCandidates.push_back(candidates[survivor]);
+			}
+			candidates.swap(survivingCandidates);
+		}
 
-	template <class RegressionType, size_t I, class... ModifierOneShotTrainingParamsTypes>
-	static impl<RegressionType, typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainModifiersAndRegressor(std::vector<typename RegressionType::SampleType> const& inputExamples,
-		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
-		typename RegressionType::OneShotTrainingParams const& regressionParams,
-		std::vector<typename RegressionType::SampleType::type>& diagnostics,
-		typename RegressionType::SampleType::type const& trainingError,
-		std::tuple<ModifierOneShotTrainingParamsTypes...> const& modifierOneShotParams,
-		std::tuple<typename ModifierOneShotTrainingParamsTypes::ModifierType::ModifierFunction...>& modifierFunctions)
-	{
-		if constexpr (I == sizeof...(ModifierOneShotTrainingParamsTypes))
+		std::string const cacheContextKey = options.Cache ? GetCacheContextKey<RegressionType>(inputExamples, targetExamples, foldPlan, metric, options.Strategy) : std::string();
+		CrossValidateCandidates<RegressionType>(inputExamples, targetExamples, foldPlan, regressionParamsToTry, modifierParamsToTry, candidates, metric, candidateTrainingErrors, candidateReports, options, cacheContextKey, tp);
+		numCompletedEvaluations += std::count_if(candidateTrainingErrors.begin(), candidateTrainingErrors.end(), isCompleted);
+		if (options.NumCompletedEvaluations != nullptr)
 		{
-			return RegressionType::Train(inputExamples,
-				targetExamples,
-				regressionParams,
-				diagnostics,
-				trainingError,
-				modifierFunctions);
+			*options.NumCompletedEvaluations = numCompletedEvaluations;
 		}
-		else
+		size_t bestIndex = 0;
+		for (size_t i = 0; i < candidates.size(); ++i)
 		{
-			using ModifierType = typename std::tuple_element<I, std::tuple<ModifierOneShotTrainingParamsTypes...>>::type::ModifierType;
-			auto& modifier = std::get<I>(modifierFunctions);
-			auto const& params = std::get<I>(modifierOneShotParams);
-			ModifierType::TrainModifier(modifier, params, inputExamples, targetExamples);
-			auto examples(inputExamples);
-			for (auto& example : examples)
+			if (candidateTrainingErrors[i] < candidateTrainingErrors[bestIndex])
 			{
-				modifier(example);
+				bestIndex = i;
 			}
-			return TrainModifiersAndRegressor<RegressionType, I + 1>(examples, targetExamples, regressionParams, diagnostics, trainingError, modifierOneShotParams, modifierFunctions);
 		}
+		if (!isCompleted(candidateTrainingErrors[bestIndex]) && isCompleted(stoppedTrainingError))
+		{
+			// trained with the error from the smaller rung on which it was scored, and reported with that rung's
+			// cross-validation; the candidate reports stay those of the unfinished full-data rung
+			candidates.assign(1, stoppedCandidate);
+			candidateTrainingErrors.assign(1, stoppedTrainingError);
+			bestIndex = 0;
+			if (options.Report != nullptr)
+			{
+				*options.Report = stoppedReport;
+			}
+			if (options.CandidateReports != nullptr)
+			{
+				*options.CandidateReports = candidateReports;
+			}
+		}
+		else
+		{
+			WriteReports(options, candidateReports, bestIndex);
+		}
+		CheckScoredBeforeStop(options, candidateTrainingErrors[bestIndex]);
+		std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> modifierFunctions;
+		return TrainModifiersAndRegressor<RegressionType>(inputExamples,
+			targetExamples,
+			regressionParamsToTry[candidates[bestIndex].first],
+			diagnostics,
+			candidateTrainingErrors[bestIndex],
+			modifierParamsToTry[candidates[bestIndex].second],
+			modifierFunctions);
 	}
 
-	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
 	template <class RegressionType, class...ModifierCrossValidationTrainingTypes>
-	static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorCrossValidation(const std::vector<typename RegressionType::SampleType>& inputExamples,
+	static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorRandomSearch(const std::vector<typename RegressionType::SampleType>& inputExamples,
 		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
 		std::string const& randomSeed,
 		ECrossValidationMetric const metric,
 		size_t const numFolds,
 		size_t const numThreads,
+		size_t const numSamples,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+		ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack)
+	{
+		FoldPlan const foldPlan(randomSeed, inputExamples.size(), numFolds);
+		TrainingOptions<typename RegressionType::SampleType::type> options;
+		options.NumThreads = numThreads;
+		return TrainRegressorRandomSearch<RegressionType>(inputExamples, targetExamples, foldPlan, metric, numSamples, options, diagnostics, regressionCrossValidationTrainingParams, modifiersCrossValidationTrainingPack...);
+	}
+
+	template <class RegressionType, class...ModifierCrossValidationTrainingTypes>
+	static impl<RegressionType, typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorRandomSearch(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		size_t const numSamples,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
 		std::vector<typename RegressionType::SampleType::type>& diagnostics,
 		typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
 		ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack)
@@ -217,45 +1341,91 @@ namespace Regressors
 		typedef typename RegressionType::SampleType::type T;
 		DLIB_ASSERT(dlib::is_learning_problem(inputExamples, targetExamples),
 			"Bad input data.");
+		DLIB_ASSERT(numSamples > 0,
+			"Input parameter numSamples must be greater than zero.");
 
 		std::tuple<ModifierCrossValidationTrainingTypes...> modifierCrossValidationParams(modifiersCrossValidationTrainingPack...);
-		
+
 		std::vector<typename RegressionType::OneShotTrainingParams> regressionParamsToTry;
 		RegressionType::IterateRegressionParams(regressionCrossValidationTrainingParams, regressionParamsToTry);
-		
+
 		std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>> modifierParamsToTry;
 		IterateModifiers(modifierCrossValidationParams, modifierParamsToTry);
 
-		dlib::thread_pool tp(numThreads);
-		std::vector<std::pair<std::pair<size_t, size_t>, T>> regressorModifierParamsIndexTrainingError;
-
-		CrossValidateTrainingParameterSets<RegressionType>(inputExamples, targetExamples, randomSeed, regressionParamsToTry, modifierParamsToTry, numFolds, metric, regressorModifierParamsIndexTrainingError, tp);
+		std::vector<size_t> regressionNumValuesPerAxis;
+		RegressionType::AppendRegressionParamsAxes(regressionCrossValidationTrainingParams, regressionNumValuesPerAxis);
+		std::vector<size_t> modifierNumValuesPerAxis;
+		AppendModifiersAxes(modifierCrossValidationParams, modifierNumValuesPerAxis);
+		std::vector<std::pair<size_t, size_t>> const candidates = SampleCandidates(regressionParamsToTry.size(), modifierParamsToTry.size(), regressionNumValuesPerAxis, modifierNumValuesPerAxis, numSamples, foldPlan.GetRandomStream());
+
+		std::unique_ptr<dlib::thread_pool> ownedThreadPool;
+		dlib::thread_pool& tp = AcquireThreadPool(options, ownedThreadPool);
+		std::string const cacheContextKey = options.Cache ? GetCacheContextKey<RegressionType>(inputExamples, targetExamples, foldPlan, metric, options.Strategy) : std::string();
+		std::vector<T> candidateTrainingErrors;
+		std::vector<CrossValidationReport<T>> candidateReports;
+		CrossValidateCandidates<RegressionType>(inputExamples, targetExamples, foldPlan, regressionParamsToTry, modifierParamsToTry, candidates, metric, candidateTrainingErrors, candidateReports, options, cacheContextKey, tp);
+		if (options.NumCompletedEvaluations != nullptr)
+		{
+			*options.NumCompletedEvaluations = std::count_if(candidateTrainingErrors.begin(), candidateTrainingErrors.end(), [](T const& trainingError)
+				{
+					return trainingError != std::numeric_limits<T>::infinity();
+				});
+		}
 		size_t bestIndex = 0;
-		for (size_t i = 0; i < regressorModifierParamsIndexTrainingError.size(); ++i)
+		for (size_t i = 0; i < candidates.size(); ++i)
 		{
-			if (regressorModifierParamsIndexTrainingError[i].second < regressorModifierParamsIndexTrainingError[bestIndex].second)
+			if (candidateTrainingErrors[i] < candidateTrainingErrors[bestIndex])
 			{
 				bestIndex = i;
 			}
 		}
+		CheckScoredBeforeStop(options, candidateTrainingErrors[bestIndex]);
+		WriteReports(options, candidateReports, bestIndex);
 		std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::ModifierFunction...> modifierFunctions;
 		return TrainModifiersAndRegressor<RegressionType>(inputExamples,
 			targetExamples,
-			regressionParamsToTry[regressorModifierParamsIndexTrainingError[bestIndex].first.first],
+			regressionParamsToTry[candidates[bestIndex].first],
 			diagnostics,
-			regressorModifierParamsIndexTrainingError[bestIndex].second,
-			modifierParamsToTry[regressorModifierParamsIndexTrainingError[bestIndex].first.second],
+			candidateTrainingErrors[bestIndex],
+			modifierParamsToTry[candidates[bestIndex].second],
 			modifierFunctions);
 	}
 
+	template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+	static std::vector<std::pair<typename RegressionType::OneShotTrainingParams, std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>> RegressorTrainer::GetRandomSearchCandidates(FoldPlan const& foldPlan,
+		size_t const numSamples,
+		typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+		ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack)
+	{
+		std::tuple<ModifierCrossValidationTrainingTypes...> modifierCrossValidationParams(modifiersCrossValidationTrainingPack...);
+
+		std::vector<typename RegressionType::OneShotTrainingParams> regressionParamsToTry;
+		RegressionType::IterateRegressionParams(regressionCrossValidationTrainingParams, regressionParamsToTry);
+
+		std::vector<std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>> modifierParamsToTry;
+		IterateModifiers(modifierCrossValidationParams, modifierParamsToTry);
+
+		std::vector<size_t> regressionNumValuesPerAxis;
+		RegressionType::AppendRegressionParamsAxes(regressionCrossValidationTrainingParams, regressionNumValuesPerAxis);
+		std::vector<size_t> modifierNumValuesPerAxis;
+		AppendModifiersAxes(modifierCrossValidationParams, modifierNumValuesPerAxis);
+
+		std::vector<std::pair<typename RegressionType::OneShotTrainingParams, std::tuple<typename ModifierCrossValidationTrainingTypes::ModifierType::OneShotTrainingParams...>>> candidateParams;
+		for (auto const& candidate : SampleCandidates(regressionParamsToTry.size(), modifierParamsToTry.size(), regressionNumValuesPerAxis, modifierNumValuesPerAxis, numSamples, foldPlan.GetRandomStream()))
+		{
+			candidateParams.emplace_back(regressionParamsToTry[candidate.first], modifierParamsToTry[candidate.second]);
+		}
+		return candidateParams;
+	}
+
 	template <typename T, size_t TotalNumParams>
-	static void RegressorTrainer::ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap,
+	static void RegressorTrainer::ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap,
 		size_t const offset)
 	{
 	}
 
 	template <typename T, size_t TotalNumParams, class... ModifierFindMinGlobalTrainingTypes, class ModifierFindMinGlobalTrainingType>
-	static void RegressorTrainer::ConfigureModifierMapping(std::array<std::pair<bool, T>, TotalNumParams>& optimiseParamsMap, 
+	static void RegressorTrainer::ConfigureModifierMapping(std::array<ParameterMapping<T>, TotalNumParams>& optimiseParamsMap, 
 		size_t const offset,
 		ModifierFindMinGlobalTrainingType const& first,
 		ModifierFindMinGlobalTrainingTypes const&... rest)
@@ -268,7 +1438,7 @@ namespace Regressors
 	static void RegressorTrainer::PackageModifierParams(col_vector<T>& lowerBound,
 		col_vector<T>& upperBound,
 		std::vector<bool>& isIntegerParam,
-		std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+		std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 		size_t const mapOffset,
 		size_t& paramsOffset)
 	{
@@ -279,7 +1449,7 @@ namespace Regressors
 	static void RegressorTrainer::PackageModifierParams(col_vector<T>& lowerBound,
 		col_vector<T>& upperBound,
 		std::vector<bool>& isIntegerParam,
-		std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+		std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 		size_t const mapOffset,
 		size_t& paramsOffset,
 		ModifierFindMinGlobalTrainingType const& first,
@@ -292,7 +1462,7 @@ namespace Regressors
 	template <typename T, size_t TotalNumParams, class... ModifierOneShotTrainingParams>
 	void RegressorTrainer::UnpackModifierParams(std::tuple<ModifierOneShotTrainingParams...>& modifierOneShotTrainingParams,
 		col_vector<T> const& vecParams,
-		std::array<std::pair<bool, T>, TotalNumParams> const& optimiseParamsMap,
+		std::array<ParameterMapping<T>, TotalNumParams> const& optimiseParamsMap,
 		size_t const mapOffset,
 		size_t& paramsOffset)
 	{
@@ -308,13 +1478,13 @@ namespace Regressors
 	}
 
 	template <typename T, size_t TotalNumParams>
-	static void RegressorTrainer::ProcessModifierFindMinGlobalParameterPack(std::array<std::pair<bool, T>, TotalNumParams> optimiseParamsMap)
+	static void RegressorTrainer::ProcessModifierFindMinGlobalParameterPack(std::array<ParameterMapping<T>, TotalNumParams> optimiseParamsMap)
 	{
 
 	}
 
 	template <typename T, size_t TotalNumParams, class ModifierFindMinGlobalTrainingType, class... ModifierFindMinGlobalTrainingTypes>
-	static void RegressorTrainer::ProcessModifierFindMinGlobalParameterPack(std::array<std::pair<bool, T>, TotalNumParams> optimiseParamsMap,
+	static void RegressorTrainer::ProcessModifierFindMinGlobalParameterPack(std::array<ParameterMapping<T>, TotalNumParams> optimiseParamsMap,
 		ModifierFindMinGlobalTrainingType const& first,
 		ModifierFindMinGlobalTrainingTypes const&... rest)
 	{
@@ -334,18 +1504,38 @@ namespace Regressors
 		typename RegressionType::FindMinGlobalTrainingParams const& regressionFindMinGlobalTrainingParams,
 		ModifierFindMinGlobalTrainingTypes const&... modifiersFindMinGlobalTrainingPack)
 	{
+		FoldPlan const foldPlan(randomSeed, inputExamples.size(), numFolds);
+		TrainingOptions<typename RegressionType::SampleType::type> options;
+		options.NumThreads = numThreads;
+		options.NumConcurrentEvaluations = numThreads;
+		return TrainRegressorFindMinGlobal<RegressionType>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, diagnostics, regressionFindMinGlobalTrainingParams, modifiersFindMinGlobalTrainingPack...);
+	}
+
+	template <class RegressionType, class... ModifierFindMinGlobalTrainingTypes>
+	static impl<RegressionType, typename ModifierFindMinGlobalTrainingTypes::ModifierType::ModifierFunction...> RegressorTrainer::TrainRegressorFindMinGlobal(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		typename RegressionType::SampleType::type const& optimisationTolerance,
+		size_t const maxNumCalls,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::FindMinGlobalTrainingParams const& regressionFindMinGlobalTrainingParams,
+		ModifierFindMinGlobalTrainingTypes const&... modifiersFindMinGlobalTrainingPack)
+	{
+		typedef typename RegressionType::SampleType SampleType;
 		typedef typename RegressionType::SampleType::type T;
 		DLIB_ASSERT(dlib::is_learning_problem(inputExamples, targetExamples),
 			"Bad input data.");
 
 		constexpr size_t totalNumParams = RegressionType::NumTotalParams + GetNumModifierParams<0ull, ModifierFindMinGlobalTrainingTypes...>();
-		std::array<std::pair<bool, T>, totalNumParams> optimiseParamsMap;
+		std::array<ParameterMapping<T>, totalNumParams> optimiseParamsMap;
 		RegressionType::ConfigureMapping(regressionFindMinGlobalTrainingParams, optimiseParamsMap);
 		ConfigureModifierMapping<T>(optimiseParamsMap, RegressionType::NumTotalParams, modifiersFindMinGlobalTrainingPack...);
 
-		const size_t numParamsToOptimise = std::accumulate(optimiseParamsMap.begin(), optimiseParamsMap.end(), 0ull, [](size_t sum, std::pair<bool, T> const& pair)
+		const size_t numParamsToOptimise = std::accumulate(optimiseParamsMap.begin(), optimiseParamsMap.end(), 0ull, [](size_t sum, ParameterMapping<T> const& mapping)
 			{
-				return pair.first ? sum + 1ull : sum;
+				return mapping.Optimise ? sum + 1ull : sum;
 			});
 		DLIB_ASSERT(numParamsToOptimise > 0,
 			"All parameters fixed - unable to run optimisation");
@@ -357,25 +1547,158 @@ namespace Regressors
 		RegressionType::PackageParameters(lowerBound, upperBound, isIntegerParam, regressionFindMinGlobalTrainingParams, optimiseParamsMap, paramsOffset);
 		PackageModifierParams<T>(lowerBound, upperBound, isIntegerParam, optimiseParamsMap, RegressionType::NumTotalParams, paramsOffset, modifiersFindMinGlobalTrainingPack...);
 
-		dlib::thread_pool tp(numThreads);
-		dlib::max_function_calls numCalls(maxNumCalls);
-		auto findMinGlobalMetric = [&](col_vector<T> const& params)
+		// the optimiser searches each parameter on its own scale; integer parameters on a log or logit scale are searched
+		// continuously and rounded once mapped back
+		std::vector<ParameterMapping<T>> searchMappings;
+		for (auto const& mapping : optimiseParamsMap)
+		{
+			if (mapping.Optimise)
+			{
+				searchMappings.push_back(mapping);
+			}
+		}
+		std::vector<bool> const isIntegerValue = isIntegerParam;
+		for (size_t i = 0; i < numParamsToOptimise; ++i)
+		{
+			lowerBound(i) = searchMappings[i].ToSearchSpace(lowerBound(i));
+			upperBound(i) = searchMappings[i].ToSearchSpace(upperBound(i));
+			isIntegerParam[i] = isIntegerValue[i] && searchMappings[i].Scale == EParameterScale::Linear;
+		}
+		auto const fromSearchSpace = [&searchMappings, &isIntegerValue](col_vector<T> const& searchParams)
+		{
+			col_vector<T> params(searchParams.size());
+			for (long i = 0; i < searchParams.size(); ++i)
+			{
+				params(i) = searchMappings[i].FromSearchSpace(searchParams(i));
+				if (isIntegerValue[i] && searchMappings[i].Scale != EParameterScale::Linear)
+				{
+					params(i) = std::round(params(i));
+				}
+			}
+			return params;
+		};
+
+		std::unique_ptr<dlib::thread_pool> ownedThreadPool;
+		dlib::thread_pool& tp = AcquireThreadPool(options, ownedThreadPool);
+		std::string const cacheContextKey = options.Cache ? GetCacheContextKey<RegressionType>(inputExamples, targetExamples, foldPlan, metric, options.Strategy) : std::string();
+
+		// the lower fidelities are prefixes of the shuffled examples, smallest first, each cross-validated in that order
+		std::vector<std::vector<SampleType>> fidelityInputExamples;
+		std::vector<std::vector<T>> fidelityTargetExamples;
+		std::vector<FoldPlan> fidelityFoldPlans;
+		std::vector<std::string> fidelityCacheContextKeys;
+		if (options.MultiFidelityMinNumExamples > 0)
+		{
+			DLIB_ASSERT(options.MultiFidelityReductionFactor > 1,
+				"Multi-fidelity reduction factor must be greater than one.");
+			DLIB_ASSERT(options.MultiFidelityMinNumExamples > foldPlan.GetNumFolds(),
+				"Multi-fidelity minimum number of examples must be greater than the number of folds.");
+
+			std::vector<size_t> fidelityNumExamples;
+			for (size_t numFidelityExamples = inputExamples.size() / options.MultiFidelityReductionFactor; numFidelityExamples >= options.MultiFidelityMinNumExamples; numFidelityExamples /= options.MultiFidelityReductionFactor)
+			{
+				fidelityNumExamples.push_back(numFidelityExamples);
+			}
+			std::reverse(fidelityNumExamples.begin(), fidelityNumExamples.end());
+
+			for (auto const numFidelityExamples : fidelityNumExamples)
+			{
+				fidelityInputExamples.emplace_back();
+				fidelityTargetExamples.emplace_back();
+				fidelityInputExamples.back().reserve(numFidelityExamples);
+				fidelityTargetExamples.back().reserve(numFidelityExamples);
+				for (size_t i = 0; i < numFidelityExamples; ++i)
+				{
+					size_t const index = foldPlan.GetShuffledIndices()[i];
+					fidelityInputExamples.back().push_back(inputExamples[index]);
+					fidelityTargetExamples.back().push_back(targetExamples[index]);
+				}
+				std::vector<size_t> fidelityOrder(numFidelityExamples);
+				std::iota(fidelityOrder.begin(), fidelityOrder.end(), 0);
+				fidelityFoldPlans.emplace_back(fidelityOrder, foldPlan.GetNumFolds());
+				fidelityCacheContextKeys.push_back(options.Cache ? GetCacheContextKey<RegressionType>(fidelityInputExamples.back(), fidelityTargetExamples.back(), fidelityFoldPlans.back(), metric, options.Strategy) : std::string());
+			}
+		}
+
+		std::atomic<size_t> numCompletedEvaluations(0);
+		std::atomic<size_t> numPrunedEvaluations(0);
+		auto findMinGlobalMetric = [&](col_vector<T> const& searchParams, std::vector<std::vector<T>> const& fidelityScores, std::vector<T>& pointFidelityScores, bool& isPruned, CrossValidationReport<T>* const pointReport)
 		{
+			col_vector<T> const params = fromSearchSpace(searchParams);
 			size_t paramsOffset = 0u;
 			typename RegressionType::OneShotTrainingParams const regressionParams(params, optimiseParamsMap, paramsOffset);
 
 			std::tuple<typename ModifierFindMinGlobalTrainingTypes::ModifierType::OneShotTrainingParams...> modifierTrainingParams;
 			UnpackModifierParams<T>(modifierTrainingParams, params, optimiseParamsMap, RegressionType::NumTotalParams, paramsOffset);
-			return CrossValidate<RegressionType>(inputExamples, targetExamples, randomSeed, regressionParams, numFolds, metric, modifierTrainingParams);
+
+			// a point moves to the next fidelity only while its score ranks among the best 1 / reduction factor of the scores
+			// on the same fidelity, counting its own, as successive halving would keep it; otherwise it stays there and is
+			// flagged as pruned, so that it is never mistaken for a full-data score
+			for (size_t fidelity = 0; fidelity < fidelityFoldPlans.size(); ++fidelity)
+			{
+				T const fidelityTrainingError = CrossValidateWithCache<RegressionType>(fidelityInputExamples[fidelity], fidelityTargetExamples[fidelity], fidelityFoldPlans[fidelity], regressionParams, metric, modifierTrainingParams, options, fidelityCacheContextKeys[fidelity], nullptr, nullptr, nullptr, tp);
+				if (fidelityTrainingError == std::numeric_limits<T>::infinity())
+				{
+					return fidelityTrainingError;
+				}
+				pointFidelityScores.push_back(fidelityTrainingError);
+
+				if (fidelity < fidelityScores.size())
+				{
+					std::vector<T> const& scores = fidelityScores[fidelity];
+					size_t const numBetter = std::lower_bound(scores.begin(), scores.end(), fidelityTrainingError) - scores.begin();
+					if (numBetter * options.MultiFidelityReductionFactor >= scores.size() + 1)
+					{
+						isPruned = true;
+						++numPrunedEvaluations;
+						return std::numeric_limits<T>::infinity();
+					}
+				}
+			}
+
+			T const trainingError = CrossValidateWithCache<RegressionType>(inputExamples, targetExamples, foldPlan, regressionParams, metric, modifierTrainingParams, options, cacheContextKey, nullptr, nullptr, pointReport, tp);
+			if (trainingError != std::numeric_limits<T>::infinity())
+			{
+				++numCompletedEvaluations;
+			}
+			return trainingError;
 		};
 
-		auto const result = dlib::find_min_global(/*tp, */findMinGlobalMetric, lowerBound, upperBound, isIntegerParam, numCalls, optimisationTolerance);
+		std::string checkpointFingerprint;
+		if (!options.CheckpointPath.empty())
+		{
+			// points can be reused by any search of the same data, folds, metric and regressor over the same parameter space
+			std::ostringstream out;
+			out << GetCacheContextKey<RegressionType>(inputExamples, targetExamples, foldPlan, metric, options.Strategy);
+			for (auto const& param : optimiseParamsMap)
+			{
+				dlib::serialize(param.Optimise, out);
+				dlib::serialize(param.FixedValue, out);
+				dlib::serialize(static_cast<int>(param.Scale), out);
+			}
+			dlib::serialize(lowerBound, out);
+			dlib::serialize(upperBound, out);
+			dlib::serialize(isIntegerParam, out);
+			dlib::serialize(options.MultiFidelityMinNumExamples, out);
+			dlib::serialize(options.MultiFidelityReductionFactor, out);
+			checkpointFingerprint = dlib::md5(out.str());
+		}
+
+		auto const result = FindMinGlobal<T>(findMinGlobalMetric, lowerBound, upperBound, isIntegerParam, maxNumCalls, optimisationTolerance, options, checkpointFingerprint, tp);
+		if (options.NumCompletedEvaluations != nullptr)
+		{
+			*options.NumCompletedEvaluations = numCompletedEvaluations;
+		}
+		if (options.NumPrunedEvaluations != nullptr)
+		{
+			*options.NumPrunedEvaluations = numPrunedEvaluations;
+		}
+		col_vector<T> const optimisedParams = fromSearchSpace(result.x);
 		paramsOffset = 0u;
-		typename RegressionType::OneShotTrainingParams optimisedRegressionParams(result.x, optimiseParamsMap, paramsOffset);
+		typename RegressionType::OneShotTrainingParams optimisedRegressionParams(optimisedParams, optimiseParamsMap, paramsOffset);
 
 		std::tuple<typename ModifierFindMinGlobalTrainingTypes::ModifierType::OneShotTrainingParams...> optimisedModifierTrainingParams;
-		UnpackModifierParams<T>(optimisedModifierTrainingParams, result.x, optimiseParamsMap, RegressionType::NumTotalParams, paramsOffset);
-
+		UnpackModifierParams<T>(optimisedModifierTrainingParams, optimisedParams, optimiseParamsMap, RegressionType::NumTotalParams, paramsOffset);
 		std::tuple<typename ModifierFindMinGlobalTrainingTypes::ModifierType::ModifierFunction...> modifierFunctions;
 		return TrainModifiersAndRegressor<RegressionType>(inputExamples,
 			targetExamples,
@@ -386,6 +1709,56 @@ namespace Regressors
 			modifierFunctions);
 	}
 
+	template <class RegressionType, class... ModifierOneShotTrainingTypes>
+	static std::future<Regressor<typename RegressionType::SampleType>> RegressorTrainer::TrainRegressorOneShotAsync(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::OneShotTrainingParams const& regressionOneShotTrainingParams,
+		ModifierOneShotTrainingTypes const&... modifiersOneShotTrainingPack)
+	{
+		return TrainAsync<RegressionType>(options, [&inputExamples, &targetExamples, &foldPlan, &diagnostics, metric, regressionOneShotTrainingParams, modifiersOneShotTrainingPack...](TrainingOptions<typename RegressionType::SampleType::type> const& taskOptions)
+			{
+				return TrainRegressorOneShot<RegressionType>(inputExamples, targetExamples, foldPlan, metric, taskOptions, diagnostics, regressionOneShotTrainingParams, modifiersOneShotTrainingPack...);
+			});
+	}
+
+	template <class RegressionType, class... ModifierCrossValidationTrainingTypes>
+	static std::future<Regressor<typename RegressionType::SampleType>> RegressorTrainer::TrainRegressorCrossValidationAsync(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::CrossValidationTrainingParams const& regressionCrossValidationTrainingParams,
+		ModifierCrossValidationTrainingTypes const&... modifiersCrossValidationTrainingPack)
+	{
+		return TrainAsync<RegressionType>(options, [&inputExamples, &targetExamples, &foldPlan, &diagnostics, metric, regressionCrossValidationTrainingParams, modifiersCrossValidationTrainingPack...](TrainingOptions<typename RegressionType::SampleType::type> const& taskOptions)
+			{
+				return TrainRegressorCrossValidation<RegressionType>(inputExamples, targetExamples, foldPlan, metric, taskOptions, diagnostics, regressionCrossValidationTrainingParams, modifiersCrossValidationTrainingPack...);
+			});
+	}
+
+	template <class RegressionType, class... ModifierFindMinGlobalTrainingTypes>
+	static std::future<Regressor<typename RegressionType::SampleType>> RegressorTrainer::TrainRegressorFindMinGlobalAsync(const std::vector<typename RegressionType::SampleType>& inputExamples,
+		std::vector<typename RegressionType::SampleType::type> const& targetExamples,
+		FoldPlan const& foldPlan,
+		ECrossValidationMetric const metric,
+		typename RegressionType::SampleType::type const& optimisationTolerance,
+		size_t const maxNumCalls,
+		TrainingOptions<typename RegressionType::SampleType::type> const& options,
+		std::vector<typename RegressionType::SampleType::type>& diagnostics,
+		typename RegressionType::FindMinGlobalTrainingParams const& regressionFindMinGlobalTrainingParams,
+		ModifierFindMinGlobalTrainingTypes const&... modifiersFindMinGlobalTrainingPack)
+	{
+		return TrainAsync<RegressionType>(options, [&inputExamples, &targetExamples, &foldPlan, &diagnostics, metric, optimisationTolerance, maxNumCalls, regressionFindMinGlobalTrainingParams, modifiersFindMinGlobalTrainingPack...](TrainingOptions<typename RegressionType::SampleType::type> const& taskOptions)
+			{
+				return TrainRegressorFindMinGlobal<RegressionType>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, taskOptions, diagnostics, regressionFindMinGlobalTrainingParams, modifiersFindMinGlobalTrainingPack...);
+			});
+	}
+
 	template <typename SampleType>
 	Regressor<SampleType>::Regressor()
 	{
@@ -442,7 +1815,27 @@ namespace Regressors
 	template <typename SampleType>
 	typename SampleType::type Regressor<SampleType>::Predict(SampleType const& input) const
 	{
-		return m_impl->Predict(input);
+		return m_impl->Predict(input, PredictionWorkspace<SampleType>::ThreadLocal());
+	}
+
+	template <typename SampleType>
+	typename SampleType::type Regressor<SampleType>::Predict(SampleType const& input, PredictionWorkspace<SampleType>& workspace) const
+	{
+		return m_impl->Predict(input, workspace);
+	}
+
+	template <typename SampleType>
+	void Regressor<SampleType>::PredictBatch(SampleType const* inputs, T* outputs, size_t const numSamples, dlib::thread_pool* const tp) const
+	{
+		m_impl->PredictBatch(inputs, outputs, numSamples, tp);
+	}
+
+	template <typename SampleType>
+	std::vector<typename SampleType::type> Regressor<SampleType>::PredictBatch(std::vector<SampleType> const& inputs, dlib::thread_pool* const tp) const
+	{
+		std::vector<T> outputs(inputs.size());
+		m_impl->PredictBatch(inputs.data(), outputs.data(), inputs.size(), tp);
+		return outputs;
 	}
 
 	template <typename SampleType>
@@ -653,10 +2046,148 @@ namespace Regressors
 	///////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <class RegressionType, class... ModifierFunctionTypes>
-	typename RegressionType::SampleType::type impl<RegressionType, ModifierFunctionTypes...>::Predict(typename RegressionType::SampleType input) const
+	typename RegressionType::SampleType::type impl<RegressionType, ModifierFunctionTypes...>::Predict(typename RegressionType::SampleType const& input) const
+	{
+		return impl::Predict(input, PredictionWorkspace<SampleType>::ThreadLocal());
+	}
+
+	template <class RegressionType, class... ModifierFunctionTypes>
+	typename RegressionType::SampleType::type impl<RegressionType, ModifierFunctionTypes...>::Predict(typename RegressionType::SampleType const& input,
+		PredictionWorkspace<typename RegressionType::SampleType>& workspace) const
+	{
+		if (HasFusedModifiers)
+		{
+			ApplyFusedModifiers(input, workspace.FusedOutput);
+			return EvaluateDecisionFunction(workspace.FusedOutput);
+		}
+		if (workspace.ModifierOutputs.size() < sizeof...(ModifierFunctionTypes))
+		{
+			workspace.ModifierOutputs.resize(sizeof...(ModifierFunctionTypes));
+		}
+		return EvaluateDecisionFunction(impl_base<SampleType>::ApplyModifiers(ModifierFunctions, input, workspace.ModifierOutputs));
+	}
+
+	template <class RegressionType, class... ModifierFunctionTypes>
+	typename RegressionType::SampleType::type impl<RegressionType, ModifierFunctionTypes...>::PredictThroughModifiers(typename RegressionType::SampleType const& input,
+		PredictionWorkspace<typename RegressionType::SampleType>& workspace) const
 	{
-		impl_base<typename RegressionType::SampleType>::ApplyModifiers(ModifierFunctions, input);
-		return Function(input);
+		if (workspace.ModifierOutputs.size() < sizeof...(ModifierFunctionTypes))
+		{
+			workspace.ModifierOutputs.resize(sizeof...(ModifierFunctionTypes));
+		}
+		return Function(impl_base<SampleType>::ApplyModifiers(ModifierFunctions, input, workspace.ModifierOutputs));
+	}
+
+	template <class RegressionType, class... ModifierFunctionTypes>
+	void impl<RegressionType, ModifierFunctionTypes...>::PredictBatch(typename RegressionType::SampleType const* inputs,
+		typename RegressionType::SampleType::type* outputs,
+		size_t const numSamples,
+		dlib::thread_pool* const tp) const
+	{
+		// each block predicts through the workspace of the thread it runs on, whose buffers are reused by every row; a thread
+		// runs one block at a time, so concurrent blocks never share modifier outputs
+		auto const predictBlock = [this, inputs, outputs](long const begin, long const end)
+		{
+			PredictionWorkspace<SampleType>& workspace = PredictionWorkspace<SampleType>::ThreadLocal();
+			if (!HasFusedModifiers && !HasKernelExpansion)
+			{
+				for (long i = begin; i < end; ++i)
+				{
+					outputs[i] = impl::Predict(inputs[i], workspace);
+				}
+				return;
+			}
+
+			// samples are passed a chunk at a time through the fused modifiers, as one matrix product with one sample per
+			// column, and through the kernel expansion, with one sample per row; the chunk matrices keep their size, so the
+			// workspace is not reallocated for a final partial chunk
+			long const chunkSize = static_cast<long>(BatchChunkSize);
+			if (HasFusedModifiers)
+			{
+				workspace.BatchInputs.set_size(FusedMatrix.nc(), chunkSize);
+				workspace.BatchOutputs.set_size(FusedMatrix.nr(), chunkSize);
+				workspace.FusedOutput.set_size(FusedMatrix.nr());
+			}
+			if (workspace.ModifierOutputs.size() < sizeof...(ModifierFunctionTypes))
+			{
+				workspace.ModifierOutputs.resize(sizeof...(ModifierFunctionTypes));
+			}
+			for (long chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize)
+			{
+				long const numChunkSamples = std::min(chunkSize, end - chunkBegin);
+				if (HasFusedModifiers)
+				{
+					for (long j = 0; j < numChunkSamples; ++j)
+					{
+						SampleType const& input = inputs[chunkBegin + j];
+						for (long k = 0; k < FusedMatrix.nc(); ++k)
+						{
+							workspace.BatchInputs(k, j) = input(k);
+						}
+					}
+
+					// summed in the same order as ApplyFusedModifiers, so batch and single predictions agree exactly
+					for (long r = 0; r < FusedMatrix.nr(); ++r)
+					{
+						T* const outputRow = &workspace.BatchOutputs(r, 0);
+						std::fill(outputRow, outputRow + numChunkSamples, T(0));
+						for (long k = 0; k < FusedMatrix.nc(); ++k)
+						{
+							T const weight = FusedMatrix(r, k);
+							T const* const inputRow = &workspace.BatchInputs(k, 0);
+							for (long j = 0; j < numChunkSamples; ++j)
+							{
+								outputRow[j] += weight * inputRow[j];
+							}
+						}
+					}
+				}
+
+				for (long j = 0; j < numChunkSamples; ++j)
+				{
+					SampleType const* modifiedInput;
+					if (HasFusedModifiers)
+					{
+						for (long r = 0; r < FusedMatrix.nr(); ++r)
+						{
+							workspace.FusedOutput(r) = workspace.BatchOutputs(r, j) + FusedOffset(r);
+						}
+						modifiedInput = &workspace.FusedOutput;
+					}
+					else
+					{
+						modifiedInput = &impl_base<SampleType>::ApplyModifiers(ModifierFunctions, inputs[chunkBegin + j], workspace.ModifierOutputs);
+					}
+
+					if constexpr (HasKernelExpansion)
+					{
+						workspace.BatchSamples.set_size(chunkSize, modifiedInput->size());
+						for (long k = 0; k < modifiedInput->size(); ++k)
+						{
+							workspace.BatchSamples(j, k) = (*modifiedInput)(k);
+						}
+					}
+					else
+					{
+						outputs[chunkBegin + j] = Function(*modifiedInput);
+					}
+				}
+
+				if constexpr (HasKernelExpansion)
+				{
+					Expansion.Evaluate(workspace.BatchSamples, numChunkSamples, outputs + chunkBegin, workspace.BatchKernelValues);
+				}
+			}
+		};
+
+		if (tp == nullptr || tp->num_threads_in_pool() < 2 || numSamples < MinParallelBatchSize)
+		{
+			predictBlock(0, static_cast<long>(numSamples));
+		}
+		else
+		{
+			dlib::parallel_for_blocked(*tp, 0, static_cast<long>(numSamples), predictBlock);
+		}
 	}
 
 	template <class RegressionType, class... ModifierFunctionTypes>
@@ -694,13 +2225,89 @@ namespace Regressors
 		std::tuple<ModifierFunctionTypes...> const& modifierFunctions,
 		typename T const& trainingError,
 		typename RegressionType::OneShotTrainingParams const& regressorTrainingParams) :
-		TrainingError(trainingError), TrainedRegressorParams(regressorTrainingParams), Function(function), ModifierFunctions(modifierFunctions)
+		TrainingError(trainingError), TrainedRegressorParams(regressorTrainingParams), Function(function), ModifierFunctions(modifierFunctions), HasFusedModifiers(false)
+	{
+		PreparePrediction();
+	}
+
+	template <class RegressionType, class... ModifierFunctionTypes>
+	impl<RegressionType, ModifierFunctionTypes...>::impl() : TrainingError(std::numeric_limits<T>::max()), HasFusedModifiers(false)
+	{
+	}
+
+	template <class RegressionType, class... ModifierFunctionTypes>
+	void impl<RegressionType, ModifierFunctionTypes...>::PreparePrediction()
+	{
+		FuseModifiers();
+		if constexpr (HasKernelExpansion)
+		{
+			Expansion = typename RegressionType::KernelExpansionType(Function);
+		}
+	}
+
+	template <class RegressionType, class... ModifierFunctionTypes>
+	void impl<RegressionType, ModifierFunctionTypes...>::FuseModifiers()
+	{
+		// every modifier is affine, but a lone modifier is cheaper applied directly than as a dense matrix, as is a chain of
+		// diagonal and selecting modifiers such as normalisation and feature selection, which would otherwise become a
+		// dense product over every input ordinate; a chain that starts with feature selection does not know the size of
+		// its inputs
+		HasFusedModifiers = false;
+		if constexpr (sizeof...(ModifierFunctionTypes) > 1 && (ModifierFunctionTypes::HasDenseTransform || ...))
+		{
+			long const numInputs = std::get<0>(ModifierFunctions).GetNumInputs();
+			if (numInputs > 0)
+			{
+				FusedMatrix = dlib::identity_matrix<T>(numInputs);
+				FusedOffset = dlib::zeros_matrix<T>(numInputs, 1);
+				ComposeModifiers(numInputs);
+				HasFusedModifiers = true;
+			}
+		}
+	}
+
+	template <class RegressionType, class... ModifierFunctionTypes> template <size_t I>
+	void impl<RegressionType, ModifierFunctionTypes...>::ComposeModifiers(long const numInputs)
 	{
+		if constexpr (I < sizeof...(ModifierFunctionTypes))
+		{
+			dlib::matrix<T> stageMatrix;
+			col_vector<T> stageOffset;
+			std::get<I>(ModifierFunctions).GetAffineTransform(numInputs, stageMatrix, stageOffset);
+			FusedOffset = stageMatrix * FusedOffset + stageOffset;
+			FusedMatrix = stageMatrix * FusedMatrix;
+			ComposeModifiers<I + 1>(stageMatrix.nr());
+		}
+	}
+
+	template <class RegressionType, class... ModifierFunctionTypes>
+	void impl<RegressionType, ModifierFunctionTypes...>::ApplyFusedModifiers(SampleType const& input, SampleType& output) const
+	{
+		DLIB_ASSERT(input.size() == FusedMatrix.nc(),
+			"Input has the wrong number of ordinates.");
+		output.set_size(FusedMatrix.nr());
+		for (long r = 0; r < FusedMatrix.nr(); ++r)
+		{
+			T sum = 0;
+			for (long k = 0; k < FusedMatrix.nc(); ++k)
+			{
+				sum += FusedMatrix(r, k) * input(k);
+			}
+			output(r) = sum + FusedOffset(r);
+		}
 	}
 
 	template <class RegressionType, class... ModifierFunctionTypes>
-	impl<RegressionType, ModifierFunctionTypes...>::impl() : TrainingError(std::numeric_limits<T>::max())
+	typename RegressionType::SampleType::type impl<RegressionType, ModifierFunctionTypes...>::EvaluateDecisionFunction(typename RegressionType::SampleType const& modifiedInput) const
 	{
+		if constexpr (HasKernelExpansion)
+		{
+			return Expansion(modifiedInput);
+		}
+		else
+		{
+			return Function(modifiedInput);
+		}
 	}
 
 	template <class RegressionType2, class... ModifierFunctionTypes2>
@@ -719,6 +2326,7 @@ namespace Regressors
 		dlib::deserialize(item.ModifierFunctions, in);
 		dlib::deserialize(item.TrainingError, in);
 		deserialize(item.Function, in);
+		item.PreparePrediction();
 	}
 
 	template <class RegressionType, class... ModifierFunctionTypes>
@@ -768,18 +2376,19 @@ namespace Regressors
 	}
 
 	template <typename SampleType> template <size_t I, class... ModifierFunctionTypes>
-	static void RegressorTrainer::impl_base<SampleType>::ApplyModifiers(std::tuple<ModifierFunctionTypes...> const& modifierFunctions,
-		typename SampleType& input)
+	static SampleType const& RegressorTrainer::impl_base<SampleType>::ApplyModifiers(std::tuple<ModifierFunctionTypes...> const& modifierFunctions,
+		SampleType const& input,
+		std::vector<SampleType>& modifierOutputs)
 	{
 		if constexpr (I == sizeof...(ModifierFunctionTypes))
 		{
-			return;
+			return input;
 		}
 		else
 		{
 			auto const& function = std::get<I>(modifierFunctions);
-			function(input);
-			ApplyModifiers<I + 1>(modifierFunctions, input);
+			function(input, modifierOutputs[I]);
+			return ApplyModifiers<I + 1>(modifierFunctions, modifierOutputs[I], modifierOutputs);
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+#include <map>
+#include <memory>
+
+namespace Regressors
+{
+	inline TaskDispatcher::TaskDispatcher(dlib::thread_pool& tp) :
+		ThreadPool(tp),
+		IsDispatching(false)
+	{
+	}
+
+	inline TaskDispatcher::~TaskDispatcher()
+	{
+		if (DispatchThread.joinable())
+		{
+			DispatchThread.join();
+		}
+	}
+
+	inline void TaskDispatcher::Submit(dlib::thread_pool& tp,
+		std::function<void()> task)
+	{
+		GetDispatcher(tp).Enqueue(std::move(task));
+	}
+
+	inline TaskDispatcher& TaskDispatcher::GetDispatcher(dlib::thread_pool& tp)
+	{
+		// dispatchers are kept for the life of the program; an idle one holds no thread
+		static std::mutex registryMutex;
+		static std::map<dlib::thread_pool*, std::unique_ptr<TaskDispatcher>> dispatchers;
+		std::lock_guard<std::mutex> lock(registryMutex);
+		std::unique_ptr<TaskDispatcher>& dispatcher = dispatchers[&tp];
+		if (!dispatcher)
+		{
+			dispatcher.reset(new TaskDispatcher(tp));
+		}
+		return *dispatcher;
+	}
+
+	inline void TaskDispatcher::Enqueue(std::function<void()> task)
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Tasks.push_back(std::move(task));
+		if (!IsDispatching)
+		{
+			// a previous dispatch thread has already left the queue once IsDispatching is cleared, so joining it is brief
+			IsDispatching = true;
+			if (DispatchThread.joinable())
+			{
+				DispatchThread.join();
+			}
+			DispatchThread = std::thread(&TaskDispatcher::Dispatch, this);
+		}
+	}
+
+	inline void TaskDispatcher::Dispatch()
+	{
+		for (;;)
+		{
+			std::function<void()> task;
+			{
+				std::lock_guard<std::mutex> lock(Mutex);
+				if (Tasks.empty())
+				{
+					IsDispatching = false;
+					return;
+				}
+				task = std::move(Tasks.front());
+				Tasks.pop_front();
+			}
+			// waits here, rather than in Submit, for one of the pool's threads to become free
+			ThreadPool.add_task_by_value(task);
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace Regressors
+{
+	template <typename T>
+	TrainingOptions<T>::TrainingOptions() :
+		NumThreads(1),
+		ThreadPool(nullptr),
+		NumConcurrentEvaluations(1),
+		Cache(nullptr),
+		Strategy(ECrossValidationStrategy::KFold),
+		Racing(ERacingRule::Off),
+		RacingConfidence(2.0),
+		RacingMinFolds(2),
+		NumPrunedEvaluations(nullptr),
+		NumModifierTrainings(nullptr),
+		Report(nullptr),
+		CandidateReports(nullptr),
+		Deadline(std::chrono::steady_clock::time_point::max()),
+		CancellationToken(nullptr),
+		NumCompletedEvaluations(nullptr),
+		MultiFidelityMinNumExamples(0),
+		MultiFidelityReductionFactor(3),
+		TaskMemoryBudget(nullptr)
+	{
+	}
+
+	template <typename T>
+	bool TrainingOptions<T>::IsStopRequested() const
+	{
+		return (CancellationToken != nullptr && *CancellationToken) || std::chrono::steady_clock::now() >= Deadline;
+	}
+
+	template <typename T>
+	bool TrainingOptions<T>::IsReportRequested() const
+	{
+		return Report != nullptr || CandidateReports != nullptr;
+	}
+}
@@ -0,0 +1,292 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MLLIB_VECTOR_MATH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MLLIB_TARGET_AVX2
+#define MLLIB_TARGET_AVX512
+#else
+#define MLLIB_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define MLLIB_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#endif
+
+namespace Regressors
+{
+	namespace VectorMath
+	{
+		// arguments beyond which the exponential overflows to infinity or underflows to zero; clamping to them keeps the
+		// scale factors below in range
+		static double const ExpMaxArgument = 710.0;
+		static double const ExpMinArgument = -746.0;
+		static double const Log2E = 1.4426950408889634;
+		// ln 2 split so that n * Ln2High is exact for the n used here
+		static double const Ln2High = 0.6931471805599453;
+		static double const Ln2Low = 2.3190468138462996e-17;
+		// 1.5 * 2^52; adding it to an integral double leaves the integer in the low bits of the mantissa
+		static double const IntegerMagic = 6755399441055744.0;
+		// Taylor coefficients 1 / k! of exp on [-ln 2 / 2, ln 2 / 2], highest order first
+		static double const ExpCoefficients[] = {
+			1.6059043836821613e-10, 2.08767569878681e-09, 2.505210838544172e-08, 2.755731922398589e-07,
+			2.7557319223985893e-06, 2.48015873015873e-05, 0.0001984126984126984, 0.001388888888888889,
+			0.008333333333333333, 0.041666666666666664, 0.16666666666666666, 0.5, 1.0, 1.0 };
+		// below this the hyperbolic tangent is x + x^3 P(x^2) / Q(x^2), with Q monic; above it 1 - 2 / (exp(2x) + 1)
+		static double const TanhRationalLimit = 0.625;
+		static double const TanhP[] = { -9.64399179425052238628e-1, -9.92877231001918586564e1, -1.61468768441708447952e3 };
+		static double const TanhQ[] = { 1.12811678491632931402e2, 2.23548839060100448583e3, 4.84406305325125486048e3 };
+
+		inline EInstructionSet DetectInstructionSet()
+		{
+#if defined(MLLIB_VECTOR_MATH_X86) && defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			int const maxLeaf = info[0];
+			__cpuid(info, 1);
+			bool const osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+			bool const hasFMA = (info[2] & (1 << 12)) != 0;
+			if (!osSavesYmm || maxLeaf < 7)
+			{
+				return EInstructionSet::Scalar;
+			}
+			bool const osSavesZmm = (_xgetbv(0) & 0xE6) == 0xE6;
+			__cpuidex(info, 7, 0);
+			if (osSavesZmm && (info[1] & (1 << 16)) != 0)
+			{
+				return EInstructionSet::AVX512;
+			}
+			if (hasFMA && (info[1] & (1 << 5)) != 0)
+			{
+				return EInstructionSet::AVX2;
+			}
+			return EInstructionSet::Scalar;
+#elif defined(MLLIB_VECTOR_MATH_X86)
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f"))
+			{
+				return EInstructionSet::AVX512;
+			}
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+			{
+				return EInstructionSet::AVX2;
+			}
+			return EInstructionSet::Scalar;
+#else
+			return EInstructionSet::Scalar;
+#endif
+		}
+
+		inline EInstructionSet GetInstructionSet()
+		{
+			static EInstructionSet const instructionSet = DetectInstructionSet();
+			return instructionSet;
+		}
+
+#if defined(MLLIB_VECTOR_MATH_X86)
+		// 2^n for integral n within the normal exponent range
+		MLLIB_TARGET_AVX2 inline __m256d PowerOfTwoAVX2(__m256d const n)
+		{
+			__m256d const magic = _mm256_set1_pd(IntegerMagic);
+			__m256i const integer = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(n, magic)), _mm256_castpd_si256(magic));
+			return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(integer, _mm256_set1_epi64x(1023)), 52));
+		}
+
+		MLLIB_TARGET_AVX2 inline __m256d ExpAVX2(__m256d const x)
+		{
+			__m256d const clamped = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(ExpMinArgument)), _mm256_set1_pd(ExpMaxArgument));
+			// exp(x) = 2^n exp(r), with |r| <= ln 2 / 2
+			__m256d const n = _mm256_round_pd(_mm256_mul_pd(clamped, _mm256_set1_pd(Log2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(Ln2High), clamped);
+			r = _mm256_fnmadd_pd(n, _mm256_set1_pd(Ln2Low), r);
+
+			__m256d result = _mm256_set1_pd(ExpCoefficients[0]);
+			for (size_t k = 1; k < sizeof(ExpCoefficients) / sizeof(ExpCoefficients[0]); ++k)
+			{
+				result = _mm256_fmadd_pd(result, r, _mm256_set1_pd(ExpCoefficients[k]));
+			}
+
+			// 2^n as two factors that each stay normal, so results near overflow and underflow are rounded only once
+			__m256d const nLow = _mm256_floor_pd(_mm256_mul_pd(n, _mm256_set1_pd(0.5)));
+			result = _mm256_mul_pd(_mm256_mul_pd(result, PowerOfTwoAVX2(nLow)), PowerOfTwoAVX2(_mm256_sub_pd(n, nLow)));
+			return _mm256_blendv_pd(result, x, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+		}
+
+		MLLIB_TARGET_AVX2 inline __m256d TanhAVX2(__m256d const x)
+		{
+			__m256d const signMask = _mm256_set1_pd(-0.0);
+			__m256d const magnitude = _mm256_andnot_pd(signMask, x);
+
+			// both forms are evaluated on the magnitude and given the sign of x, which keeps the sign of zero
+			__m256d const z = _mm256_mul_pd(magnitude, magnitude);
+			__m256d p = _mm256_fmadd_pd(_mm256_set1_pd(TanhP[0]), z, _mm256_set1_pd(TanhP[1]));
+			p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(TanhP[2]));
+			__m256d q = _mm256_add_pd(z, _mm256_set1_pd(TanhQ[0]));
+			q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(TanhQ[1]));
+			q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(TanhQ[2]));
+			__m256d const small = _mm256_fmadd_pd(_mm256_mul_pd(magnitude, z), _mm256_div_pd(p, q), magnitude);
+
+			__m256d const one = _mm256_set1_pd(1.0);
+			__m256d const e = ExpAVX2(_mm256_add_pd(magnitude, magnitude));
+			__m256d const large = _mm256_sub_pd(one, _mm256_div_pd(_mm256_set1_pd(2.0), _mm256_add_pd(e, one)));
+
+			__m256d const result = _mm256_blendv_pd(large, small, _mm256_cmp_pd(magnitude, _mm256_set1_pd(TanhRationalLimit), _CMP_LT_OQ));
+			return _mm256_or_pd(result, _mm256_and_pd(signMask, x));
+		}
+
+		// GCC's AVX-512 min and max intrinsics start from an undefined vector, which -Wmaybe-uninitialized reports at every
+		// inlined use
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+		MLLIB_TARGET_AVX512 inline __m512d PowerOfTwoAVX512(__m512d const n)
+		{
+			__m512d const magic = _mm512_set1_pd(IntegerMagic);
+			__m512i const integer = _mm512_sub_epi64(_mm512_castpd_si512(_mm512_add_pd(n, magic)), _mm512_castpd_si512(magic));
+			return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_add_epi64(integer, _mm512_set1_epi64(1023)), 52));
+		}
+
+		MLLIB_TARGET_AVX512 inline __m512d ExpAVX512(__m512d const x)
+		{
+			__m512d const clamped = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(ExpMinArgument)), _mm512_set1_pd(ExpMaxArgument));
+			__m512d const n = _mm512_roundscale_pd(_mm512_mul_pd(clamped, _mm512_set1_pd(Log2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(Ln2High), clamped);
+			r = _mm512_fnmadd_pd(n, _mm512_set1_pd(Ln2Low), r);
+
+			__m512d result = _mm512_set1_pd(ExpCoefficients[0]);
+			for (size_t k = 1; k < sizeof(ExpCoefficients) / sizeof(ExpCoefficients[0]); ++k)
+			{
+				result = _mm512_fmadd_pd(result, r, _mm512_set1_pd(ExpCoefficients[k]));
+			}
+
+			__m512d const nLow = _mm512_roundscale_pd(_mm512_mul_pd(n, _mm512_set1_pd(0.5)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+			result = _mm512_mul_pd(_mm512_mul_pd(result, PowerOfTwoAVX512(nLow)), PowerOfTwoAVX512(_mm512_sub_pd(n, nLow)));
+			return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q), result, x);
+		}
+
+		MLLIB_TARGET_AVX512 inline __m512d TanhAVX512(__m512d const x)
+		{
+			__m512i const signMask = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+			__m512d const magnitude = _mm512_castsi512_pd(_mm512_andnot_si512(signMask, _mm512_castpd_si512(x)));
+
+			__m512d const z = _mm512_mul_pd(magnitude, magnitude);
+			__m512d p = _mm512_fmadd_pd(_mm512_set1_pd(TanhP[0]), z, _mm512_set1_pd(TanhP[1]));
+			p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(TanhP[2]));
+			__m512d q = _mm512_add_pd(z, _mm512_set1_pd(TanhQ[0]));
+			q = _mm512_fmadd_pd(q, z, _mm512_set1_pd(TanhQ[1]));
+			q = _mm512_fmadd_pd(q, z, _mm512_set1_pd(TanhQ[2]));
+			__m512d const small = _mm512_fmadd_pd(_mm512_mul_pd(magnitude, z), _mm512_div_pd(p, q), magnitude);
+
+			__m512d const one = _mm512_set1_pd(1.0);
+			__m512d const e = ExpAVX512(_mm512_add_pd(magnitude, magnitude));
+			__m512d const large = _mm512_sub_pd(one, _mm512_div_pd(_mm512_set1_pd(2.0), _mm512_add_pd(e, one)));
+
+			__m512d const result = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(magnitude, _mm512_set1_pd(TanhRationalLimit), _CMP_LT_OQ), large, small);
+			return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(result), _mm512_and_si512(signMask, _mm512_castpd_si512(x))));
+		}
+
+		// the final partial vector goes through the same lanes as full vectors, padded, so that no result depends on
+		// where its value sits in the array
+		template <__m256d (*Function)(__m256d)>
+		MLLIB_TARGET_AVX2 void TransformAVX2(double* values, size_t const numValues)
+		{
+			size_t i = 0;
+			for (; i + 4 <= numValues; i += 4)
+			{
+				_mm256_storeu_pd(values + i, Function(_mm256_loadu_pd(values + i)));
+			}
+			if (i < numValues)
+			{
+				double lanes[4] = { 0.0, 0.0, 0.0, 0.0 };
+				std::copy(values + i, values + numValues, lanes);
+				_mm256_storeu_pd(lanes, Function(_mm256_loadu_pd(lanes)));
+				std::copy(lanes, lanes + (numValues - i), values + i);
+			}
+		}
+
+		template <__m512d (*Function)(__m512d)>
+		MLLIB_TARGET_AVX512 void TransformAVX512(double* values, size_t const numValues)
+		{
+			size_t i = 0;
+			for (; i + 8 <= numValues; i += 8)
+			{
+				_mm512_storeu_pd(values + i, Function(_mm512_loadu_pd(values + i)));
+			}
+			if (i < numValues)
+			{
+				__mmask8 const tail = static_cast<__mmask8>((1u << (numValues - i)) - 1u);
+				_mm512_mask_storeu_pd(values + i, tail, Function(_mm512_maskz_loadu_pd(tail, values + i)));
+			}
+		}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+		template <typename T>
+		void Exp(T* values, size_t const numValues)
+		{
+			Exp(values, numValues, GetInstructionSet());
+		}
+
+		template <typename T>
+		void Exp(T* values, size_t const numValues, EInstructionSet const instructionSet)
+		{
+#if defined(MLLIB_VECTOR_MATH_X86)
+			if constexpr (std::is_same<T, double>::value)
+			{
+				EInstructionSet const supportedInstructionSet = std::min(instructionSet, GetInstructionSet());
+				if (supportedInstructionSet == EInstructionSet::AVX512)
+				{
+					TransformAVX512<ExpAVX512>(values, numValues);
+					return;
+				}
+				if (supportedInstructionSet == EInstructionSet::AVX2)
+				{
+					TransformAVX2<ExpAVX2>(values, numValues);
+					return;
+				}
+			}
+#endif
+			for (size_t i = 0; i < numValues; ++i)
+			{
+				values[i] = std::exp(values[i]);
+			}
+		}
+
+		template <typename T>
+		void Tanh(T* values, size_t const numValues)
+		{
+			Tanh(values, numValues, GetInstructionSet());
+		}
+
+		template <typename T>
+		void Tanh(T* values, size_t const numValues, EInstructionSet const instructionSet)
+		{
+#if defined(MLLIB_VECTOR_MATH_X86)
+			if constexpr (std::is_same<T, double>::value)
+			{
+				EInstructionSet const supportedInstructionSet = std::min(instructionSet, GetInstructionSet());
+				if (supportedInstructionSet == EInstructionSet::AVX512)
+				{
+					TransformAVX512<TanhAVX512>(values, numValues);
+					return;
+				}
+				if (supportedInstructionSet == EInstructionSet::AVX2)
+				{
+					TransformAVX2<TanhAVX2>(values, numValues);
+					return;
+				}
+			}
+#endif
+			for (size_t i = 0; i < numValues; ++i)
+			{
+				values[i] = std::tanh(values[i]);
+			}
+		}
+	}
+}
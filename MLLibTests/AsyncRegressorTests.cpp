@@ -0,0 +1,202 @@
+#include "gtest/gtest.h"
+#include <MLLib/Regressor.h>
+#include <dlib/md5.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+template <typename T>
+std::string GetMD5(T const& item)
+{
+	using namespace dlib;
+	std::stringstream ss;
+	serialize(item, ss);
+	return dlib::md5(ss);
+}
+
+TEST(AsyncTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 4;
+	T const optimisationTolerance = 1.e-2;
+	size_t const maxNumCalls = 20;
+
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+	ModifierTypes::NormaliserModifier<SampleType>::FindMinGlobalTrainingParams normaliserFMGParams;
+
+	RadialBasisKRR::OneShotTrainingParams radialBasisKRROSParams;
+	radialBasisKRROSParams.MaxBasisFunctions = 400;
+	radialBasisKRROSParams.Lambda = 1e-6;
+	radialBasisKRROSParams.KernelOneShotTrainingParams.Gamma = 1.0;
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-1, 1.0 };
+
+	RadialBasisKRR::FindMinGlobalTrainingParams radialBasisKRRFMGParams;
+	radialBasisKRRFMGParams.LowerLambda = 1.e-6;
+	radialBasisKRRFMGParams.UpperLambda = 10.0;
+	radialBasisKRRFMGParams.LowerMaxBasisFunctions = 50;
+	radialBasisKRRFMGParams.UpperMaxBasisFunctions = 100;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	dlib::thread_pool sharedThreadPool(numThreads);
+	TrainingOptions<T> options;
+	options.ThreadPool = &sharedThreadPool;
+
+	std::vector<T> oneShotDiagnostics;
+	Regressor<SampleType> const oneShotRegressor = RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, oneShotDiagnostics, radialBasisKRROSParams, normaliserOSParams);
+	std::vector<T> crossValidationDiagnostics;
+	Regressor<SampleType> const crossValidationRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, crossValidationDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	std::vector<T> findMinGlobalDiagnostics;
+	Regressor<SampleType> const findMinGlobalRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, findMinGlobalDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+
+	// trainings queued together on the shared pool must match the same trainings run one at a time
+	size_t const numRepeats = 3;
+	std::vector<std::vector<T>> asyncOneShotDiagnostics(numRepeats);
+	std::vector<std::vector<T>> asyncCrossValidationDiagnostics(numRepeats);
+	std::vector<std::vector<T>> asyncFindMinGlobalDiagnostics(numRepeats);
+	std::vector<std::future<Regressor<SampleType>>> asyncOneShotRegressors;
+	std::vector<std::future<Regressor<SampleType>>> asyncCrossValidationRegressors;
+	std::vector<std::future<Regressor<SampleType>>> asyncFindMinGlobalRegressors;
+	for (size_t i = 0; i < numRepeats; ++i)
+	{
+		asyncOneShotRegressors.push_back(RegressorTrainer::TrainRegressorOneShotAsync<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, asyncOneShotDiagnostics[i], radialBasisKRROSParams, normaliserOSParams));
+		asyncCrossValidationRegressors.push_back(RegressorTrainer::TrainRegressorCrossValidationAsync<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, asyncCrossValidationDiagnostics[i], radialBasisKRRCVParams, normaliserCVParams));
+		asyncFindMinGlobalRegressors.push_back(RegressorTrainer::TrainRegressorFindMinGlobalAsync<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, asyncFindMinGlobalDiagnostics[i], radialBasisKRRFMGParams, normaliserFMGParams));
+	}
+
+	for (size_t i = 0; i < numRepeats; ++i)
+	{
+		EXPECT_EQ(GetMD5(asyncOneShotRegressors[i].get()), GetMD5(oneShotRegressor));
+		EXPECT_EQ(GetMD5(asyncOneShotDiagnostics[i]), GetMD5(oneShotDiagnostics));
+		EXPECT_EQ(GetMD5(asyncCrossValidationRegressors[i].get()), GetMD5(crossValidationRegressor));
+		EXPECT_EQ(GetMD5(asyncCrossValidationDiagnostics[i]), GetMD5(crossValidationDiagnostics));
+		EXPECT_EQ(GetMD5(asyncFindMinGlobalRegressors[i].get()), GetMD5(findMinGlobalRegressor));
+		EXPECT_EQ(GetMD5(asyncFindMinGlobalDiagnostics[i]), GetMD5(findMinGlobalDiagnostics));
+	}
+
+	// failures are delivered through the future; kernel ridge regression provides no out-of-bag values
+	TrainingOptions<T> outOfBagOptions(options);
+	outOfBagOptions.Strategy = ECrossValidationStrategy::OutOfBag;
+	std::vector<T> outOfBagDiagnostics;
+	auto outOfBagRegressor = RegressorTrainer::TrainRegressorOneShotAsync<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, outOfBagOptions, outOfBagDiagnostics, radialBasisKRROSParams, normaliserOSParams);
+	EXPECT_THROW(outOfBagRegressor.get(), RegressorTrainer::RegressorError);
+}
+
+TEST(AsyncTrainingSubmission, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 4;
+	size_t const numQueued = 4 * numThreads;
+
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+
+	RadialBasisKRR::OneShotTrainingParams radialBasisKRROSParams;
+	radialBasisKRROSParams.MaxBasisFunctions = 400;
+	radialBasisKRROSParams.Lambda = 1e-6;
+	radialBasisKRROSParams.KernelOneShotTrainingParams.Gamma = 1.0;
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	dlib::thread_pool sharedThreadPool(numThreads);
+	TrainingOptions<T> options;
+	options.ThreadPool = &sharedThreadPool;
+
+	std::vector<T> oneShotDiagnostics;
+	Regressor<SampleType> const oneShotRegressor = RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, oneShotDiagnostics, radialBasisKRROSParams, normaliserOSParams);
+
+	// every worker is held on a latch, so none of the queued trainings can start until it is released
+	std::mutex latchMutex;
+	std::condition_variable latchReleased;
+	bool isReleased = false;
+	std::atomic<size_t> numHeld(0);
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		sharedThreadPool.add_task_by_value([&]()
+			{
+				++numHeld;
+				std::unique_lock<std::mutex> lock(latchMutex);
+				latchReleased.wait(lock, [&]() { return isReleased; });
+			});
+	}
+	while (numHeld < numThreads)
+	{
+		std::this_thread::yield();
+	}
+
+	// submitting more trainings than the pool has threads must still return while the workers are held
+	std::vector<std::vector<T>> asyncDiagnostics(numQueued);
+	std::vector<std::future<Regressor<SampleType>>> asyncRegressors;
+	auto submission = std::async(std::launch::async, [&]()
+		{
+			for (size_t i = 0; i < numQueued; ++i)
+			{
+				asyncRegressors.push_back(RegressorTrainer::TrainRegressorOneShotAsync<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, asyncDiagnostics[i], radialBasisKRROSParams, normaliserOSParams));
+			}
+		});
+	bool const isSubmittedWhileHeld = submission.wait_for(std::chrono::seconds(60)) == std::future_status::ready;
+	{
+		std::lock_guard<std::mutex> lock(latchMutex);
+		isReleased = true;
+	}
+	latchReleased.notify_all();
+	submission.get();
+	EXPECT_TRUE(isSubmittedWhileHeld);
+
+	ASSERT_EQ(asyncRegressors.size(), numQueued);
+	for (size_t i = 0; i < numQueued; ++i)
+	{
+		EXPECT_EQ(GetMD5(asyncRegressors[i].get()), GetMD5(oneShotRegressor));
+		EXPECT_EQ(GetMD5(asyncDiagnostics[i]), GetMD5(oneShotDiagnostics));
+	}
+}
@@ -201,4 +201,631 @@ TEST(CrossValidationTraining, RegressorTests)
 	auto const linearLagrangeIRLSRegressor = Regressors::RegressorTrainer::TrainRegressorCrossValidation<LinearLagrangeIRLS>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, linearLagrangeIRLSDiagnostics, linearLagrangeIRLSCVParams, featureSelectionCVParams, PCACVParams);
 	EXPECT_EQ(GetMD5(linearLagrangeIRLSRegressor), linearLagrangeIRLSRegressorMD5);
 	EXPECT_EQ(GetMD5(linearLagrangeIRLSDiagnostics), linearLagrangeIRLSDiagnosticsMD5);
-}
\ No newline at end of file
+}
+TEST(CrossValidationCacheTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::SupportVectorRegression<KernelTypes::LinearKernel<SampleType>> LinearSVR;
+	typedef RegressionTypes::IterativelyReweightedLeastSquaresRegression<LinkFunctionTypes::LogitLinkFunction<KernelTypes::LinearKernel<SampleType>>> LinearLogitIRLS;
+	typedef RegressionTypes::IterativelyReweightedLeastSquaresRegression<LinkFunctionTypes::LagrangeLinkFunction<KernelTypes::LinearKernel<SampleType>>> LinearLagrangeIRLS;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+	std::string const cacheFilePath = "CrossValidationCacheTraining.dat";
+	std::remove(cacheFilePath.c_str());
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+
+	// the cache size only changes training speed, so the eight parameter sets below reduce to four distinct evaluations
+	LinearSVR::CrossValidationTrainingParams linearSVRCVParams;
+	linearSVRCVParams.CToTry = { 1.0, 2.0 };
+	linearSVRCVParams.EpsilonToTry = { 1.e-3 };
+	linearSVRCVParams.EpsilonInsensitivityToTry = { 0.1, 0.2 };
+	linearSVRCVParams.CacheSizeToTry = { 100, 200 };
+
+	std::vector<T> uncachedDiagnostics;
+	auto const uncachedRegressor = RegressorTrainer::TrainRegressorCrossValidation<LinearSVR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, uncachedDiagnostics, linearSVRCVParams, normaliserCVParams);
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	{
+		CrossValidationCache<T> cache(cacheFilePath);
+		TrainingOptions<T> options;
+		options.NumThreads = numThreads;
+		options.Cache = &cache;
+
+		std::vector<T> cachedDiagnostics;
+		auto const cachedRegressor = RegressorTrainer::TrainRegressorCrossValidation<LinearSVR>(inputExamples, targetExamples, foldPlan, metric, options, cachedDiagnostics, linearSVRCVParams, normaliserCVParams);
+		EXPECT_EQ(GetMD5(cachedRegressor), GetMD5(uncachedRegressor));
+		EXPECT_EQ(GetMD5(cachedDiagnostics), GetMD5(uncachedDiagnostics));
+		EXPECT_EQ(cache.GetNumEntries(), 4u);
+	}
+
+	// a second run reloads every result from disk and must reach the same regressor without cross-validating any of the
+	// eight parameter sets again
+	{
+		CrossValidationCache<T> reloadedCache(cacheFilePath);
+		EXPECT_EQ(reloadedCache.GetNumEntries(), 4u);
+		TrainingOptions<T> reloadedOptions;
+		reloadedOptions.NumThreads = numThreads;
+		reloadedOptions.Cache = &reloadedCache;
+
+		std::vector<T> reloadedDiagnostics;
+		auto const reloadedRegressor = RegressorTrainer::TrainRegressorCrossValidation<LinearSVR>(inputExamples, targetExamples, foldPlan, metric, reloadedOptions, reloadedDiagnostics, linearSVRCVParams, normaliserCVParams);
+		EXPECT_EQ(GetMD5(reloadedRegressor), GetMD5(uncachedRegressor));
+		EXPECT_EQ(reloadedCache.GetNumEntries(), 4u);
+		EXPECT_EQ(reloadedCache.GetNumHits(), 8u);
+	}
+
+	// a record torn by an interrupted write is dropped, and records added afterwards can still be read back
+	{
+		std::ofstream tornFile(cacheFilePath, std::ios::binary | std::ios::app);
+		dlib::serialize(std::string("torn"), tornFile);
+	}
+	{
+		CrossValidationCache<T> tornCache(cacheFilePath);
+		EXPECT_EQ(tornCache.GetNumEntries(), 4u);
+		tornCache.Insert("appended", 1.0);
+	}
+	{
+		CrossValidationCache<T> appendedCache(cacheFilePath);
+		EXPECT_EQ(appendedCache.GetNumEntries(), 5u);
+		T appendedResult = 0.0;
+		EXPECT_TRUE(appendedCache.Find("appended", appendedResult));
+		EXPECT_EQ(appendedResult, 1.0);
+		EXPECT_FALSE(appendedCache.Find("torn", appendedResult));
+	}
+
+	// a record whose key length is corrupt is dropped even though reading it fails to allocate rather than running out
+	{
+		std::ofstream corruptFile(cacheFilePath, std::ios::binary | std::ios::app);
+		dlib::serialize(std::numeric_limits<unsigned long>::max(), corruptFile);
+	}
+	{
+		CrossValidationCache<T> corruptCache(cacheFilePath);
+		EXPECT_EQ(corruptCache.GetNumEntries(), 5u);
+	}
+	std::remove(cacheFilePath.c_str());
+
+	// IRLS regressors share a regressor type enum, so their link functions must still give the same parameters different keys
+	std::ostringstream logitKey;
+	LinearLogitIRLS::SerializeCacheKey(LinearLogitIRLS::OneShotTrainingParams(), logitKey);
+	std::ostringstream lagrangeKey;
+	LinearLagrangeIRLS::SerializeCacheKey(LinearLagrangeIRLS::OneShotTrainingParams(), lagrangeKey);
+	EXPECT_NE(logitKey.str(), lagrangeKey.str());
+
+	// the link function and its kernel are keyed by their enums rather than by compiler-specific type names, so keys
+	// written by one build are found by another
+	typedef RegressionTypes::IterativelyReweightedLeastSquaresRegression<LinkFunctionTypes::LogitLinkFunction<KernelTypes::RadialBasisKernel<SampleType>>> RadialBasisLogitIRLS;
+	std::ostringstream radialBasisLogitKey;
+	RadialBasisLogitIRLS::SerializeCacheKey(RadialBasisLogitIRLS::OneShotTrainingParams(), radialBasisLogitKey);
+	std::ostringstream radialBasisLogitPrefix;
+	serialize(ELinkFunctionTypes::logit, radialBasisLogitPrefix);
+	serialize(EKernelTypes::radialBasis, radialBasisLogitPrefix);
+	EXPECT_EQ(radialBasisLogitKey.str().compare(0, radialBasisLogitPrefix.str().size(), radialBasisLogitPrefix.str()), 0);
+}
+
+TEST(CrossValidationRacingTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.MaxBasisFunctionsToTry = { 400 };
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3, 1.0, 1.e3 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-3, 1.e-1, 1.0, 1.e1 };
+
+	std::vector<T> fullDiagnostics;
+	auto const fullRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, fullDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+
+	// the exact rule only stops candidates whose completed folds already exceed the best score, so it must select the
+	// same regressor as the full grid however the candidates are scheduled
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	size_t numPruned = 0;
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.Racing = ERacingRule::Exact;
+	options.NumPrunedEvaluations = &numPruned;
+
+	std::vector<T> racedDiagnostics;
+	auto const racedRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, racedDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(racedRegressor), GetMD5(fullRegressor));
+	EXPECT_EQ(GetMD5(racedDiagnostics), GetMD5(fullDiagnostics));
+	EXPECT_LT(numPruned, radialBasisKRRCVParams.LambdaToTry.size() * radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry.size());
+
+	// scored one after another on a single thread, the lightly regularised candidates come first and set a best score
+	// that the heavily regularised ones, which all but ignore the inputs, exceed within their first folds
+	RadialBasisKRR::CrossValidationTrainingParams dominatedKRRCVParams;
+	dominatedKRRCVParams.MaxBasisFunctionsToTry = { 400 };
+	dominatedKRRCVParams.LambdaToTry = { 1.e-3, 1.e6 };
+	dominatedKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-1, 1.0 };
+	size_t const dominatedGridSize = dominatedKRRCVParams.LambdaToTry.size() * dominatedKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry.size();
+
+	TrainingOptions<T> serialOptions;
+	serialOptions.NumThreads = 1;
+	std::vector<T> unracedDiagnostics;
+	auto const unracedRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, serialOptions, unracedDiagnostics, dominatedKRRCVParams, normaliserCVParams);
+
+	serialOptions.Racing = ERacingRule::Exact;
+	numPruned = 0;
+	serialOptions.NumPrunedEvaluations = &numPruned;
+	std::vector<T> serialRacedDiagnostics;
+	auto const serialRacedRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, serialOptions, serialRacedDiagnostics, dominatedKRRCVParams, normaliserCVParams);
+	EXPECT_GT(numPruned, 0u);
+	EXPECT_LT(numPruned, dominatedGridSize);
+	EXPECT_EQ(serialRacedRegressor.GetTrainingError(), unracedRegressor.GetTrainingError());
+	EXPECT_EQ(GetMD5(serialRacedRegressor), GetMD5(unracedRegressor));
+	EXPECT_EQ(GetMD5(serialRacedDiagnostics), GetMD5(unracedDiagnostics));
+}
+
+TEST(CrossValidationAnalyticLOOTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+	typedef RegressionTypes::SupportVectorRegression<KernelTypes::LinearKernel<SampleType>> LinearSVR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.MaxBasisFunctionsToTry = { 400 };
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3, 1.0 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-2, 1.e-1, 1.0 };
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.Strategy = ECrossValidationStrategy::AnalyticLOO;
+
+	// the selected regressor is refitted on every example, so its diagnostics are the leave-one-out values it was scored on
+	std::vector<T> diagnostics;
+	auto const regressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, diagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	ASSERT_EQ(diagnostics.size(), numExamples);
+	dlib::running_stats<T> rs_sq;
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		T const diff = diagnostics[e] - targetExamples[e];
+		rs_sq.add(diff * diff);
+	}
+	EXPECT_DOUBLE_EQ(regressor.GetTrainingError(), rs_sq.mean());
+
+	// other regressors have no leave-one-out values to score on
+	LinearSVR::OneShotTrainingParams linearSVROSParams;
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+	std::vector<T> linearSVRDiagnostics;
+	EXPECT_THROW(RegressorTrainer::TrainRegressorOneShot<LinearSVR>(inputExamples, targetExamples, foldPlan, metric, options, linearSVRDiagnostics, linearSVROSParams, normaliserOSParams), RegressorTrainer::RegressorError);
+}
+
+TEST(CrossValidationOutOfBagTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::RandomForestRegression<KernelTypes::DenseExtractor<SampleType>> DenseRF;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::LinearKernel<SampleType>> LinearKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumAbsoluteMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+
+	DenseRF::CrossValidationTrainingParams denseRFCVParams;
+	denseRFCVParams.NumTreesToTry = { 100, 200 };
+	denseRFCVParams.MinSamplesPerLeafToTry = { 3, 5 };
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.Strategy = ECrossValidationStrategy::OutOfBag;
+
+	// the selected forest is refitted on every example, so its diagnostics are the out-of-bag values it was scored on
+	std::vector<T> diagnostics;
+	auto const regressor = RegressorTrainer::TrainRegressorCrossValidation<DenseRF>(inputExamples, targetExamples, foldPlan, metric, options, diagnostics, denseRFCVParams);
+	ASSERT_EQ(diagnostics.size(), numExamples);
+	dlib::running_stats<T> rs_abs;
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		rs_abs.add(std::abs(diagnostics[e] - targetExamples[e]));
+	}
+	EXPECT_DOUBLE_EQ(regressor.GetTrainingError(), rs_abs.mean());
+
+	// other regressors have no out-of-bag values to score on
+	LinearKRR::OneShotTrainingParams linearKRROSParams;
+	std::vector<T> linearKRRDiagnostics;
+	EXPECT_THROW(RegressorTrainer::TrainRegressorOneShot<LinearKRR>(inputExamples, targetExamples, foldPlan, metric, options, linearKRRDiagnostics, linearKRROSParams), RegressorTrainer::RegressorError);
+}
+
+TEST(CrossValidationSharedThreadPoolTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+	typedef RegressionTypes::SupportVectorRegression<KernelTypes::LinearKernel<SampleType>> LinearSVR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-1, 1.0 };
+
+	LinearSVR::CrossValidationTrainingParams linearSVRCVParams;
+	linearSVRCVParams.CToTry = { 1.0, 2.0 };
+	linearSVRCVParams.EpsilonInsensitivityToTry = { 0.1, 0.2 };
+
+	std::vector<T> radialBasisKRRDiagnostics;
+	auto const radialBasisKRRRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, radialBasisKRRDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	std::vector<T> linearSVRDiagnostics;
+	auto const linearSVRRegressor = RegressorTrainer::TrainRegressorCrossValidation<LinearSVR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, linearSVRDiagnostics, linearSVRCVParams, normaliserCVParams);
+
+	// back to back trainings on one pool must match trainings that each create their own
+	dlib::thread_pool sharedThreadPool(numThreads);
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> options;
+	options.ThreadPool = &sharedThreadPool;
+
+	std::vector<T> sharedRadialBasisKRRDiagnostics;
+	auto const sharedRadialBasisKRRRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, sharedRadialBasisKRRDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	std::vector<T> sharedLinearSVRDiagnostics;
+	auto const sharedLinearSVRRegressor = RegressorTrainer::TrainRegressorCrossValidation<LinearSVR>(inputExamples, targetExamples, foldPlan, metric, options, sharedLinearSVRDiagnostics, linearSVRCVParams, normaliserCVParams);
+
+	EXPECT_EQ(GetMD5(sharedRadialBasisKRRRegressor), GetMD5(radialBasisKRRRegressor));
+	EXPECT_EQ(GetMD5(sharedRadialBasisKRRDiagnostics), GetMD5(radialBasisKRRDiagnostics));
+	EXPECT_EQ(GetMD5(sharedLinearSVRRegressor), GetMD5(linearSVRRegressor));
+	EXPECT_EQ(GetMD5(sharedLinearSVRDiagnostics), GetMD5(linearSVRDiagnostics));
+}
+
+TEST(CrossValidationReportTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-1, 1.0 };
+
+	std::vector<T> diagnostics;
+	auto const regressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, diagnostics, radialBasisKRRCVParams, normaliserCVParams);
+
+	// asking for a report must not change the selected regressor, whose training error is the report's selection metric
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	CrossValidationReport<T> report;
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.Report = &report;
+
+	std::vector<T> reportedDiagnostics;
+	auto const reportedRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, reportedDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(reportedRegressor), GetMD5(regressor));
+	EXPECT_EQ(GetMD5(reportedDiagnostics), GetMD5(diagnostics));
+	EXPECT_EQ(report.Metrics.SumSquareMean, reportedRegressor.GetTrainingError());
+	EXPECT_LE(report.Metrics.SumSquareMean, report.Metrics.SumSquareMax);
+	EXPECT_LE(report.Metrics.SumAbsoluteMean, report.Metrics.SumAbsoluteMax);
+	ASSERT_EQ(report.FoldMetrics.size(), numFolds);
+	ASSERT_EQ(report.FoldSeconds.size(), numFolds);
+
+	T foldSumSquareMax = 0.0;
+	for (size_t fold = 0; fold < numFolds; ++fold)
+	{
+		foldSumSquareMax = std::max(foldSumSquareMax, report.FoldMetrics[fold].SumSquareMax);
+		EXPECT_GE(report.FoldSeconds[fold], 0.0);
+	}
+	EXPECT_EQ(foldSumSquareMax, report.Metrics.SumSquareMax);
+
+	// every candidate's report is collected during the search, and the selected one is handed back rather than measured
+	// again, so even its fold timings match
+	std::vector<CrossValidationReport<T>> candidateReports;
+	options.CandidateReports = &candidateReports;
+	std::vector<T> candidateReportedDiagnostics;
+	auto const candidateReportedRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, candidateReportedDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(candidateReportedRegressor), GetMD5(regressor));
+	ASSERT_EQ(candidateReports.size(), radialBasisKRRCVParams.LambdaToTry.size() * radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry.size());
+
+	size_t numSelected = 0;
+	for (auto const& candidateReport : candidateReports)
+	{
+		ASSERT_EQ(candidateReport.FoldMetrics.size(), numFolds);
+		EXPECT_GE(candidateReport.Metrics.SumSquareMean, report.Metrics.SumSquareMean);
+		if (candidateReport.FoldSeconds == report.FoldSeconds)
+		{
+			++numSelected;
+			EXPECT_EQ(candidateReport.Metrics.SumSquareMean, candidateReportedRegressor.GetTrainingError());
+		}
+	}
+	EXPECT_EQ(numSelected, 1u);
+
+	// reports are cached with the selection metric, so a second search served entirely from the cache reports exactly
+	// what the first one measured, fold timings included
+	CrossValidationCache<T> cache;
+	options.Cache = &cache;
+	std::vector<T> firstCachedDiagnostics;
+	RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, firstCachedDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(cache.GetNumHits(), 0u);
+	CrossValidationReport<T> const firstReport = report;
+	std::vector<CrossValidationReport<T>> const firstCandidateReports = candidateReports;
+
+	std::vector<T> secondCachedDiagnostics;
+	auto const cachedRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, secondCachedDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(cachedRegressor), GetMD5(regressor));
+	EXPECT_EQ(cache.GetNumHits(), candidateReports.size());
+	EXPECT_EQ(report.FoldSeconds, firstReport.FoldSeconds);
+	EXPECT_EQ(report.Metrics.SumSquareMean, firstReport.Metrics.SumSquareMean);
+	ASSERT_EQ(candidateReports.size(), firstCandidateReports.size());
+	for (size_t c = 0; c < candidateReports.size(); ++c)
+	{
+		EXPECT_EQ(candidateReports[c].FoldSeconds, firstCandidateReports[c].FoldSeconds);
+		EXPECT_EQ(candidateReports[c].Metrics.SumSquareMean, firstCandidateReports[c].Metrics.SumSquareMean);
+		ASSERT_EQ(candidateReports[c].FoldMetrics.size(), numFolds);
+	}
+}
+
+TEST(CrossValidationMemoryBudgetTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-1, 1.0 };
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.NumConcurrentEvaluations = 4;
+
+	std::vector<T> diagnostics;
+	auto const regressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, diagnostics, radialBasisKRRCVParams, normaliserCVParams);
+
+	// every candidate shares the default basis size, so every fold has the same estimate
+	size_t const foldMemory = RadialBasisKRR::EstimatePeakMemory(RadialBasisKRR::OneShotTrainingParams(), foldPlan.GetTrainIndices(0).size(), numOrdinates);
+	EXPECT_GT(foldMemory, 0u);
+
+	// at most two folds train at once, which must not change the result
+	MemoryBudget budget(2 * foldMemory);
+	TrainingOptions<T> budgetedOptions(options);
+	budgetedOptions.TaskMemoryBudget = &budget;
+	std::vector<T> budgetedDiagnostics;
+	auto const budgetedRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, budgetedOptions, budgetedDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(budgetedRegressor), GetMD5(regressor));
+	EXPECT_EQ(GetMD5(budgetedDiagnostics), GetMD5(diagnostics));
+	EXPECT_LE(budget.GetPeakNumBytesInUse(), budget.GetNumBytes());
+	EXPECT_GE(budget.GetPeakNumBytesInUse(), foldMemory);
+	EXPECT_EQ(budget.GetNumBytesInUse(), 0u);
+
+	// a budget smaller than any one fold still trains every fold, one at a time
+	MemoryBudget smallBudget(1);
+	budgetedOptions.TaskMemoryBudget = &smallBudget;
+	std::vector<T> smallBudgetDiagnostics;
+	auto const smallBudgetRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, budgetedOptions, smallBudgetDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(smallBudgetRegressor), GetMD5(regressor));
+	EXPECT_EQ(smallBudget.GetPeakNumBytesInUse(), foldMemory);
+	EXPECT_EQ(smallBudget.GetNumBytesInUse(), 0u);
+}
+
+TEST(CrossValidationModifiedFoldTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+	ModifierTypes::InputPCAModifier<SampleType>::CrossValidationTrainingParams PCACVParams;
+	PCACVParams.TargetVarianceToTry = { 0.6, 0.8 };
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.MaxBasisFunctionsToTry = { 400 };
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-1, 1.0 };
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	size_t numModifierTrainings = 0;
+	options.NumModifierTrainings = &numModifierTrainings;
+
+	// the four regression parameter sets paired with each modifier set share its folds rather than training the
+	// modifiers again, whether they are scored together or one after another
+	std::vector<T> diagnostics;
+	auto const regressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, diagnostics, radialBasisKRRCVParams, normaliserCVParams, PCACVParams);
+	EXPECT_EQ(numModifierTrainings, PCACVParams.TargetVarianceToTry.size() * numFolds);
+
+	TrainingOptions<T> serialOptions(options);
+	serialOptions.NumThreads = 1;
+	numModifierTrainings = 0;
+	std::vector<T> serialDiagnostics;
+	auto const serialRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, serialOptions, serialDiagnostics, radialBasisKRRCVParams, normaliserCVParams, PCACVParams);
+	EXPECT_EQ(numModifierTrainings, PCACVParams.TargetVarianceToTry.size() * numFolds);
+	EXPECT_EQ(GetMD5(serialRegressor), GetMD5(regressor));
+	EXPECT_EQ(GetMD5(serialDiagnostics), GetMD5(diagnostics));
+
+	// a shared fold scores a parameter set exactly as training its modifiers afresh does
+	RadialBasisKRR::CrossValidationTrainingParams singleKRRCVParams(radialBasisKRRCVParams);
+	singleKRRCVParams.LambdaToTry = { 1.e-3 };
+	singleKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.0 };
+	ModifierTypes::InputPCAModifier<SampleType>::CrossValidationTrainingParams singlePCACVParams;
+	singlePCACVParams.TargetVarianceToTry = { 0.8 };
+	std::vector<T> singleDiagnostics;
+	auto const singleRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, singleDiagnostics, singleKRRCVParams, normaliserCVParams, singlePCACVParams);
+	EXPECT_EQ(numModifierTrainings, numFolds);
+
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+	ModifierTypes::InputPCAModifier<SampleType>::OneShotTrainingParams PCAOSParams;
+	PCAOSParams.TargetVariance = 0.8;
+	RadialBasisKRR::OneShotTrainingParams radialBasisKRROSParams;
+	radialBasisKRROSParams.MaxBasisFunctions = 400;
+	radialBasisKRROSParams.Lambda = 1.e-3;
+	radialBasisKRROSParams.KernelOneShotTrainingParams.Gamma = 1.0;
+	TrainingOptions<T> oneShotOptions;
+	oneShotOptions.NumThreads = numThreads;
+	std::vector<T> oneShotDiagnostics;
+	auto const oneShotRegressor = RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, oneShotOptions, oneShotDiagnostics, radialBasisKRROSParams, normaliserOSParams, PCAOSParams);
+	EXPECT_EQ(singleRegressor.GetTrainingError(), oneShotRegressor.GetTrainingError());
+	EXPECT_EQ(GetMD5(singleRegressor), GetMD5(oneShotRegressor));
+}
@@ -11,6 +11,26 @@ std::string GetMD5(T const& item)
 	return dlib::md5(ss);
 }
 
+// the full-data scores that a find_min_global search checkpointed, in the order it evaluated them
+static std::vector<double> ReadCheckpointScores(std::string const& checkpointPath)
+{
+	std::ifstream checkpoint(checkpointPath, std::ios::binary);
+	std::string fingerprint;
+	size_t numEvaluations;
+	dlib::deserialize(fingerprint, checkpoint);
+	dlib::deserialize(numEvaluations, checkpoint);
+	std::vector<double> scores;
+	for (size_t i = 0; i < numEvaluations; ++i)
+	{
+		dlib::matrix<double, 0, 1> x;
+		double y;
+		dlib::deserialize(x, checkpoint);
+		dlib::deserialize(y, checkpoint);
+		scores.push_back(-y);
+	}
+	return scores;
+}
+
 TEST(FindMinGlobalTraining, RegressorTests) 
 {
 	using namespace Regressors;
@@ -75,6 +95,11 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	std::string const linearLagrangeIRLSRegressorMD5 = "";
 	std::string const linearLagrangeIRLSDiagnosticsMD5 = "";
 
+	// the reference results were recorded by dlib's serial search, which a batch of one candidate point reproduces
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> serialOptions;
+	serialOptions.NumThreads = numThreads;
+
 	ModifierTypes::NormaliserModifier<SampleType>::FindMinGlobalTrainingParams normaliserFMGParams;
 	ModifierTypes::InputPCAModifier<SampleType>::FindMinGlobalTrainingParams PCAFMGParams;
 	PCAFMGParams.LowerTargetVariance = 0.5;
@@ -89,7 +114,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	linearKRRFMGParams.UpperLambda = 10.0;
 	linearKRRFMGParams.LowerMaxBasisFunctions = 50;
 	linearKRRFMGParams.UpperMaxBasisFunctions = 100;
-	auto const linearKRRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<LinearKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, linearKRRDiagnostics, linearKRRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const linearKRRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<LinearKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, linearKRRDiagnostics, linearKRRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(linearKRRRegressor), linearKRRRegressorMD5);
 	EXPECT_EQ(GetMD5(linearKRRDiagnostics), linearKRRDiagnosticsMD5);
 	
@@ -105,7 +130,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	polynomialKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperCoeff = 1.0;
 	polynomialKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerDegree = 1.0;
 	polynomialKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 1.0;
-	auto const polynomialKRRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<PolynomialKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, polynomialKRRDiagnostics, polynomialKRRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const polynomialKRRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<PolynomialKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, polynomialKRRDiagnostics, polynomialKRRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(polynomialKRRRegressor), polynomialKRRRegressorMD5);
 	EXPECT_EQ(GetMD5(polynomialKRRDiagnostics), polynomialKRRDiagnosticsMD5);
 
@@ -117,7 +142,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	radialBasisKRRFMGParams.UpperMaxBasisFunctions = 100;
 	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
 	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
-	auto const radialBasisKRRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, radialBasisKRRDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const radialBasisKRRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, radialBasisKRRDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(radialBasisKRRRegressor), radialBasisKRRRegressorMD5);
 	EXPECT_EQ(GetMD5(radialBasisKRRDiagnostics), radialBasisKRRDiagnosticsMD5);
 
@@ -131,7 +156,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	sigmoidKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
 	sigmoidKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerCoeff = 0.0;
 	sigmoidKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperCoeff = 1.0;
-	auto const sigmoidKRRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<SigmoidKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, sigmoidKRRDiagnostics, sigmoidKRRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const sigmoidKRRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<SigmoidKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, sigmoidKRRDiagnostics, sigmoidKRRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(sigmoidKRRRegressor), sigmoidKRRRegressorMD5);
 	EXPECT_EQ(GetMD5(sigmoidKRRDiagnostics), sigmoidKRRDiagnosticsMD5);
 
@@ -145,7 +170,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	linearSVRFMGParams.UpperEpsilonInsensitivity = 1.0;
 	linearSVRFMGParams.LowerCacheSize = 50;
 	linearSVRFMGParams.UpperCacheSize = 300;
-	auto const linearSVRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<LinearSVR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, linearSVRDiagnostics, linearSVRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const linearSVRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<LinearSVR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, linearSVRDiagnostics, linearSVRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(linearSVRRegressor), linearSVRRegressorMD5);
 	EXPECT_EQ(GetMD5(linearSVRDiagnostics), linearSVRDiagnosticsMD5);
 
@@ -165,7 +190,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	polynomialSVRFMGParams.KernelFindMinGlobalTrainingParams.UpperCoeff = 1.0;
 	polynomialSVRFMGParams.KernelFindMinGlobalTrainingParams.LowerDegree = 1.0;
 	polynomialSVRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 1.0;
-	auto const polynomialSVRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<PolynomialSVR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, polynomialSVRDiagnostics, polynomialSVRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const polynomialSVRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<PolynomialSVR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, polynomialSVRDiagnostics, polynomialSVRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(polynomialSVRRegressor), polynomialSVRRegressorMD5);
 	EXPECT_EQ(GetMD5(polynomialSVRDiagnostics), polynomialSVRDiagnosticsMD5);
 
@@ -181,7 +206,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	radialBasisSVRFMGParams.UpperCacheSize = 300;
 	radialBasisSVRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
 	radialBasisSVRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
-	auto const radialBasisSVRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisSVR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, radialBasisSVRDiagnostics, radialBasisSVRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const radialBasisSVRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisSVR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, radialBasisSVRDiagnostics, radialBasisSVRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(radialBasisSVRRegressor), radialBasisSVRRegressorMD5);
 	EXPECT_EQ(GetMD5(radialBasisSVRDiagnostics), radialBasisSVRDiagnosticsMD5);
 
@@ -199,7 +224,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	sigmoidSVRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
 	sigmoidSVRFMGParams.KernelFindMinGlobalTrainingParams.LowerCoeff = 0.0;
 	sigmoidSVRFMGParams.KernelFindMinGlobalTrainingParams.UpperCoeff = 1.0;
-	auto const sigmoidSVRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<SigmoidSVR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, sigmoidSVRDiagnostics, sigmoidSVRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const sigmoidSVRRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<SigmoidSVR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, sigmoidSVRDiagnostics, sigmoidSVRFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(sigmoidSVRRegressor), sigmoidSVRRegressorMD5);
 	EXPECT_EQ(GetMD5(sigmoidSVRDiagnostics), sigmoidSVRDiagnosticsMD5);
 
@@ -211,7 +236,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	denseRFFMGParams.UpperMinSamplesPerLeaf = 10;
 	denseRFFMGParams.LowerSubsamplingFraction = 0.2;
 	denseRFFMGParams.UpperSubsamplingFraction = 0.8;
-	auto const denseRFRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<DenseRF>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, denseRFDiagnostics, denseRFFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const denseRFRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<DenseRF>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, denseRFDiagnostics, denseRFFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(denseRFRegressor), denseRFRegressorMD5);
 	EXPECT_EQ(GetMD5(denseRFDiagnostics), denseRFDiagnosticsMD5);
 
@@ -223,7 +248,7 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	denseRFFMGParams.UpperMinSamplesPerLeaf = 10;
 	denseRFFMGParams.LowerSubsamplingFraction = 0.2;
 	denseRFFMGParams.UpperSubsamplingFraction = 0.8;
-	auto const linearFourierIRLSRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<LinearFourierIRLS>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, linearFourierIRLSDiagnostics, linearFourierIRLSFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const linearFourierIRLSRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<LinearFourierIRLS>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, linearFourierIRLSDiagnostics, linearFourierIRLSFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(linearFourierIRLSRegressor), linearFourierIRLSRegressorMD5);
 	EXPECT_EQ(GetMD5(linearFourierIRLSDiagnostics), linearFourierIRLSDiagnosticsMD5);
 
@@ -235,7 +260,657 @@ TEST(FindMinGlobalTraining, RegressorTests)
 	denseRFFMGParams.UpperMinSamplesPerLeaf = 10;
 	denseRFFMGParams.LowerSubsamplingFraction = 0.2;
 	denseRFFMGParams.UpperSubsamplingFraction = 0.8;
-	auto const linearLagrangeIRLSRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<LinearLagrangeIRLS>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, linearLagrangeIRLSDiagnostics, linearLagrangeIRLSFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
+	auto const linearLagrangeIRLSRegressor = Regressors::RegressorTrainer::TrainRegressorFindMinGlobal<LinearLagrangeIRLS>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, serialOptions, linearLagrangeIRLSDiagnostics, linearLagrangeIRLSFMGParams, normaliserFMGParams, featureSelectionFMGParams, PCAFMGParams);
 	EXPECT_EQ(GetMD5(linearLagrangeIRLSRegressor), linearLagrangeIRLSRegressorMD5);
 	EXPECT_EQ(GetMD5(linearLagrangeIRLSDiagnostics), linearLagrangeIRLSDiagnosticsMD5);
-}
\ No newline at end of file
+}
+TEST(FindMinGlobalBatchedTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	T const optimisationTolerance = 1.e-2;
+	size_t const maxNumCalls = 40;
+	size_t const numThreads = 16;
+	size_t const numConcurrentEvaluations = 4;
+
+	ModifierTypes::NormaliserModifier<SampleType>::FindMinGlobalTrainingParams normaliserFMGParams;
+
+	RadialBasisKRR::FindMinGlobalTrainingParams radialBasisKRRFMGParams;
+	radialBasisKRRFMGParams.LowerLambda = 1.e-6;
+	radialBasisKRRFMGParams.UpperLambda = 10.0;
+	radialBasisKRRFMGParams.LowerMaxBasisFunctions = 50;
+	radialBasisKRRFMGParams.UpperMaxBasisFunctions = 100;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> threadBatchedOptions;
+	threadBatchedOptions.NumThreads = numThreads;
+	threadBatchedOptions.NumConcurrentEvaluations = numThreads;
+	TrainingOptions<T> batchedOptions;
+	batchedOptions.NumThreads = numThreads;
+	batchedOptions.NumConcurrentEvaluations = numConcurrentEvaluations;
+
+	// the seeded search proposes one point per thread on each step
+	std::vector<T> seedDiagnostics;
+	auto const seedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, seedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	std::vector<T> threadBatchedDiagnostics;
+	auto const threadBatchedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, threadBatchedOptions, threadBatchedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(threadBatchedRegressor), GetMD5(seedRegressor));
+	EXPECT_EQ(GetMD5(threadBatchedDiagnostics), GetMD5(seedDiagnostics));
+
+	// batched searches must not depend on the order in which concurrent evaluations complete
+	std::vector<T> firstBatchedDiagnostics;
+	auto const firstBatchedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, batchedOptions, firstBatchedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	std::vector<T> secondBatchedDiagnostics;
+	auto const secondBatchedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, batchedOptions, secondBatchedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(firstBatchedRegressor), GetMD5(secondBatchedRegressor));
+	EXPECT_EQ(GetMD5(firstBatchedDiagnostics), GetMD5(secondBatchedDiagnostics));
+
+	// nor on the number of threads they are spread over
+	TrainingOptions<T> singleThreadBatchedOptions;
+	singleThreadBatchedOptions.NumConcurrentEvaluations = numConcurrentEvaluations;
+	std::vector<T> singleThreadBatchedDiagnostics;
+	auto const singleThreadBatchedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, singleThreadBatchedOptions, singleThreadBatchedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(singleThreadBatchedRegressor), GetMD5(firstBatchedRegressor));
+	EXPECT_EQ(GetMD5(singleThreadBatchedDiagnostics), GetMD5(firstBatchedDiagnostics));
+}
+
+TEST(FindMinGlobalStopTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	T const optimisationTolerance = 1.e-2;
+	size_t const maxNumCalls = 40;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::FindMinGlobalTrainingParams normaliserFMGParams;
+
+	RadialBasisKRR::FindMinGlobalTrainingParams radialBasisKRRFMGParams;
+	radialBasisKRRFMGParams.LowerLambda = 1.e-6;
+	radialBasisKRRFMGParams.UpperLambda = 10.0;
+	radialBasisKRRFMGParams.LowerMaxBasisFunctions = 50;
+	radialBasisKRRFMGParams.UpperMaxBasisFunctions = 100;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
+
+	std::vector<T> seedDiagnostics;
+	auto const seedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, optimisationTolerance, numThreads, maxNumCalls, seedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+
+	// an unset token and a distant deadline leave the search untouched
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	std::atomic<bool> cancel(false);
+	size_t numCompleted = 0;
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.NumConcurrentEvaluations = numThreads;
+	options.CancellationToken = &cancel;
+	options.Deadline = std::chrono::steady_clock::now() + std::chrono::hours(24);
+	options.NumCompletedEvaluations = &numCompleted;
+
+	std::vector<T> uncancelledDiagnostics;
+	auto const uncancelledRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, uncancelledDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(uncancelledRegressor), GetMD5(seedRegressor));
+	EXPECT_EQ(GetMD5(uncancelledDiagnostics), GetMD5(seedDiagnostics));
+	EXPECT_EQ(numCompleted, maxNumCalls);
+
+	// a search cancelled before scoring any parameter set has nothing to train, which is reported rather than returned
+	cancel = true;
+	std::vector<T> cancelledDiagnostics;
+	EXPECT_THROW(RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, cancelledDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams), RegressorTrainer::TrainingStoppedError);
+	EXPECT_EQ(numCompleted, 0u);
+
+	// as is one whose deadline has already passed
+	cancel = false;
+	numCompleted = maxNumCalls;
+	options.Deadline = std::chrono::steady_clock::now();
+	std::vector<T> expiredDiagnostics;
+	EXPECT_THROW(RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, expiredDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams), RegressorTrainer::TrainingStoppedError);
+	EXPECT_EQ(numCompleted, 0u);
+
+	// a deadline part way through a serial search returns the best point scored before it, which the checkpoint records
+	std::string const checkpointPath = "FindMinGlobalStopCheckpoint.dat";
+	std::remove(checkpointPath.c_str());
+	options.NumConcurrentEvaluations = 1;
+	options.Deadline = std::chrono::steady_clock::now() + std::chrono::hours(24);
+	auto const serialStart = std::chrono::steady_clock::now();
+	std::vector<T> serialDiagnostics;
+	auto const serialRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, serialDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	auto const serialDuration = std::chrono::steady_clock::now() - serialStart;
+
+	CrossValidationReport<T> report;
+	options.Report = &report;
+	options.CheckpointPath = checkpointPath;
+	options.Deadline = std::chrono::steady_clock::now() + serialDuration / 2;
+	std::vector<T> stoppedDiagnostics;
+	auto const stoppedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, stoppedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_GT(numCompleted, 0u);
+	EXPECT_LT(numCompleted, maxNumCalls);
+	// and its report, collected while it was scored, needs no folds to be trained after the deadline
+	EXPECT_EQ(report.Metrics.SumSquareMean, stoppedRegressor.GetTrainingError());
+	EXPECT_EQ(report.FoldMetrics.size(), numFolds);
+
+	std::ifstream checkpoint(checkpointPath, std::ios::binary);
+	std::string fingerprint;
+	size_t numEvaluations;
+	dlib::deserialize(fingerprint, checkpoint);
+	dlib::deserialize(numEvaluations, checkpoint);
+	EXPECT_EQ(numEvaluations, numCompleted);
+	T bestScored = std::numeric_limits<T>::infinity();
+	for (size_t i = 0; i < numEvaluations; ++i)
+	{
+		dlib::matrix<double, 0, 1> x;
+		double y;
+		dlib::deserialize(x, checkpoint);
+		dlib::deserialize(y, checkpoint);
+		bestScored = std::min(bestScored, static_cast<T>(-y));
+	}
+	checkpoint.close();
+	std::remove(checkpointPath.c_str());
+
+	// the points scored are the first of the uninterrupted serial search, so they cannot beat its best
+	EXPECT_EQ(stoppedRegressor.GetTrainingError(), bestScored);
+	EXPECT_GE(stoppedRegressor.GetTrainingError(), serialRegressor.GetTrainingError());
+}
+
+TEST(FindMinGlobalCheckpointTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	T const optimisationTolerance = 1.e-2;
+	size_t const maxNumCalls = 40;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::FindMinGlobalTrainingParams normaliserFMGParams;
+
+	RadialBasisKRR::FindMinGlobalTrainingParams radialBasisKRRFMGParams;
+	radialBasisKRRFMGParams.LowerLambda = 1.e-6;
+	radialBasisKRRFMGParams.UpperLambda = 10.0;
+	radialBasisKRRFMGParams.LowerMaxBasisFunctions = 50;
+	radialBasisKRRFMGParams.UpperMaxBasisFunctions = 100;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
+
+	std::string const checkpointPath = "FindMinGlobalCheckpoint.dat";
+	std::remove(checkpointPath.c_str());
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	size_t numCompleted = 0;
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.NumCompletedEvaluations = &numCompleted;
+	std::vector<T> uncheckpointedDiagnostics;
+	auto const uncheckpointedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, uncheckpointedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+
+	// saving checkpoints does not change the search
+	options.CheckpointPath = checkpointPath;
+	std::vector<T> checkpointedDiagnostics;
+	auto const checkpointedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, checkpointedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(checkpointedRegressor), GetMD5(uncheckpointedRegressor));
+	EXPECT_EQ(GetMD5(checkpointedDiagnostics), GetMD5(uncheckpointedDiagnostics));
+	EXPECT_EQ(numCompleted, maxNumCalls);
+
+	// a resumed search that has already used its budget evaluates nothing and returns the same regressor
+	std::vector<T> resumedDiagnostics;
+	auto const resumedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, resumedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(resumedRegressor), GetMD5(checkpointedRegressor));
+	EXPECT_EQ(GetMD5(resumedDiagnostics), GetMD5(checkpointedDiagnostics));
+	EXPECT_EQ(numCompleted, 0u);
+
+	// a larger budget only evaluates the extra points, and can only improve on the checkpointed best
+	size_t const extraNumCalls = 10;
+	std::vector<T> extendedDiagnostics;
+	auto const extendedRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls + extraNumCalls, options, extendedDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(numCompleted, extraNumCalls);
+	EXPECT_LE(extendedRegressor.GetTrainingError(), checkpointedRegressor.GetTrainingError());
+
+	// a different search ignores the checkpoint
+	std::vector<T> otherMetricDiagnostics;
+	RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, ECrossValidationMetric::SumAbsoluteMean, optimisationTolerance, maxNumCalls, options, otherMetricDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(numCompleted, maxNumCalls);
+
+	// a checkpoint whose evaluation count is corrupt is ignored rather than used to size the evaluations
+	std::string fingerprint;
+	{
+		std::ifstream checkpointFile(checkpointPath, std::ios::binary);
+		dlib::deserialize(fingerprint, checkpointFile);
+	}
+	{
+		std::ofstream corruptFile(checkpointPath, std::ios::binary | std::ios::trunc);
+		dlib::serialize(fingerprint, corruptFile);
+		dlib::serialize(std::numeric_limits<size_t>::max(), corruptFile);
+	}
+	std::vector<T> corruptDiagnostics;
+	RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, ECrossValidationMetric::SumAbsoluteMean, optimisationTolerance, maxNumCalls, options, corruptDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(numCompleted, maxNumCalls);
+	EXPECT_EQ(GetMD5(corruptDiagnostics), GetMD5(otherMetricDiagnostics));
+
+	std::remove(checkpointPath.c_str());
+}
+
+TEST(FindMinGlobalMultiFidelityTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	T const optimisationTolerance = 1.e-2;
+	size_t const maxNumCalls = 40;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::FindMinGlobalTrainingParams normaliserFMGParams;
+
+	RadialBasisKRR::FindMinGlobalTrainingParams radialBasisKRRFMGParams;
+	radialBasisKRRFMGParams.LowerLambda = 1.e-6;
+	radialBasisKRRFMGParams.UpperLambda = 10.0;
+	radialBasisKRRFMGParams.LowerMaxBasisFunctions = 50;
+	radialBasisKRRFMGParams.UpperMaxBasisFunctions = 100;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
+
+	std::string const checkpointPath = "FindMinGlobalMultiFidelityCheckpoint.dat";
+	std::remove(checkpointPath.c_str());
+
+	// points are first scored on 12 and then 25 of the shuffled examples
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	CrossValidationReport<T> report;
+	size_t numCompleted = 0;
+	size_t numPruned = 0;
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.NumConcurrentEvaluations = 4;
+	options.MultiFidelityMinNumExamples = 12;
+	options.MultiFidelityReductionFactor = 2;
+	options.Report = &report;
+	options.NumCompletedEvaluations = &numCompleted;
+	options.NumPrunedEvaluations = &numPruned;
+	options.CheckpointPath = checkpointPath;
+
+	std::vector<T> multiFidelityDiagnostics;
+	auto const multiFidelityRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, multiFidelityDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+
+	// some points are pruned on a subsample while others are promoted to the full data; pruned points still use up calls
+	// but are not completed evaluations
+	EXPECT_GT(numPruned, 0u);
+	EXPECT_LT(numPruned, maxNumCalls);
+	EXPECT_EQ(numCompleted, maxNumCalls - numPruned);
+
+	// and only the promoted points' full-data scores are checkpointed
+	std::ifstream checkpoint(checkpointPath, std::ios::binary);
+	std::string fingerprint;
+	size_t numEvaluations;
+	dlib::deserialize(fingerprint, checkpoint);
+	dlib::deserialize(numEvaluations, checkpoint);
+	checkpoint.close();
+	std::remove(checkpointPath.c_str());
+	EXPECT_EQ(numEvaluations, maxNumCalls - numPruned);
+
+	// the selected point is always scored on the full data
+	EXPECT_EQ(multiFidelityRegressor.GetTrainingError(), report.Metrics.SumSquareMean);
+	ASSERT_EQ(report.FoldMetrics.size(), numFolds);
+
+	// and which points are promoted must not depend on the number of threads
+	size_t singleThreadNumPruned = 0;
+	TrainingOptions<T> singleThreadOptions(options);
+	singleThreadOptions.NumThreads = 1;
+	singleThreadOptions.Report = nullptr;
+	singleThreadOptions.NumPrunedEvaluations = &singleThreadNumPruned;
+	singleThreadOptions.CheckpointPath.clear();
+	std::vector<T> singleThreadDiagnostics;
+	auto const singleThreadRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, singleThreadOptions, singleThreadDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(singleThreadRegressor), GetMD5(multiFidelityRegressor));
+	EXPECT_EQ(GetMD5(singleThreadDiagnostics), GetMD5(multiFidelityDiagnostics));
+	EXPECT_EQ(singleThreadNumPruned, numPruned);
+}
+
+TEST(FindMinGlobalScaleTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	T const optimisationTolerance = 1.e-2;
+	size_t const maxNumCalls = 30;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::FindMinGlobalTrainingParams normaliserFMGParams;
+
+	RadialBasisKRR::FindMinGlobalTrainingParams radialBasisKRRFMGParams;
+	radialBasisKRRFMGParams.LowerLambda = 1.e-8;
+	radialBasisKRRFMGParams.UpperLambda = 10.0;
+	radialBasisKRRFMGParams.LowerMaxBasisFunctions = 50;
+	radialBasisKRRFMGParams.UpperMaxBasisFunctions = 100;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.e-3;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 10.0;
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+
+	// an explicitly linear scale is the default search
+	std::vector<T> defaultDiagnostics;
+	auto const defaultRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, defaultDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+
+	RadialBasisKRR::FindMinGlobalTrainingParams linearKRRFMGParams(radialBasisKRRFMGParams);
+	linearKRRFMGParams.LambdaScale = EParameterScale::Linear;
+	linearKRRFMGParams.KernelFindMinGlobalTrainingParams.GammaScale = EParameterScale::Linear;
+	std::vector<T> linearDiagnostics;
+	auto const linearRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, linearDiagnostics, linearKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(linearRegressor), GetMD5(defaultRegressor));
+	EXPECT_EQ(GetMD5(linearDiagnostics), GetMD5(defaultDiagnostics));
+
+	// parameters spanning several decades are searched on a log scale, and the search is still independent of the number
+	// of threads
+	RadialBasisKRR::FindMinGlobalTrainingParams logKRRFMGParams(radialBasisKRRFMGParams);
+	logKRRFMGParams.LambdaScale = EParameterScale::Log;
+	logKRRFMGParams.KernelFindMinGlobalTrainingParams.GammaScale = EParameterScale::Log;
+	std::vector<T> logDiagnostics;
+	auto const logRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, options, logDiagnostics, logKRRFMGParams, normaliserFMGParams);
+	EXPECT_TRUE(std::isfinite(logRegressor.GetTrainingError()));
+
+	TrainingOptions<T> singleThreadOptions(options);
+	singleThreadOptions.NumThreads = 1;
+	std::vector<T> singleThreadDiagnostics;
+	auto const singleThreadRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, singleThreadOptions, singleThreadDiagnostics, logKRRFMGParams, normaliserFMGParams);
+	EXPECT_EQ(GetMD5(singleThreadRegressor), GetMD5(logRegressor));
+	EXPECT_EQ(GetMD5(singleThreadDiagnostics), GetMD5(logDiagnostics));
+
+	// the support vector penalty is continuous, so a log scale reaches the decades below one rather than rounding them to
+	// zero or one
+	typedef RegressionTypes::SupportVectorRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisSVR;
+	RadialBasisSVR::FindMinGlobalTrainingParams logSVRFMGParams;
+	logSVRFMGParams.LowerC = 1.e-2;
+	logSVRFMGParams.UpperC = 10.0;
+	logSVRFMGParams.CScale = EParameterScale::Log;
+	logSVRFMGParams.LowerEpsilon = 1.e-3;
+	logSVRFMGParams.UpperEpsilon = 1.e-3;
+	logSVRFMGParams.LowerEpsilonInsensitivity = 0.1;
+	logSVRFMGParams.UpperEpsilonInsensitivity = 0.1;
+	logSVRFMGParams.LowerCacheSize = 200;
+	logSVRFMGParams.UpperCacheSize = 200;
+	logSVRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
+	logSVRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 1.0;
+
+	std::string const checkpointPath = "FindMinGlobalScaleSVRCheckpoint.dat";
+	std::remove(checkpointPath.c_str());
+	TrainingOptions<T> svrOptions(options);
+	svrOptions.CheckpointPath = checkpointPath;
+	std::vector<T> logSVRDiagnostics;
+	auto const logSVRRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisSVR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, svrOptions, logSVRDiagnostics, logSVRFMGParams, normaliserFMGParams);
+	std::ifstream checkpoint(checkpointPath, std::ios::binary);
+	std::string fingerprint;
+	size_t numEvaluations;
+	dlib::deserialize(fingerprint, checkpoint);
+	dlib::deserialize(numEvaluations, checkpoint);
+	EXPECT_EQ(numEvaluations, maxNumCalls);
+
+	// C is the only parameter searched, so each checkpointed point holds its logarithm alone
+	ParameterMapping<T> cMapping;
+	cMapping.Optimise = true;
+	cMapping.Scale = EParameterScale::Log;
+	size_t numBelowHalf = 0;
+	size_t numNonInteger = 0;
+	for (size_t i = 0; i < numEvaluations; ++i)
+	{
+		dlib::matrix<double, 0, 1> x;
+		double y;
+		dlib::deserialize(x, checkpoint);
+		dlib::deserialize(y, checkpoint);
+		ASSERT_EQ(x.size(), 1);
+		T const c = cMapping.FromSearchSpace(x(0));
+		EXPECT_GE(c, logSVRFMGParams.LowerC * (1.0 - 1.e-12));
+		EXPECT_LE(c, logSVRFMGParams.UpperC * (1.0 + 1.e-12));
+		EXPECT_TRUE(std::isfinite(y));
+		numBelowHalf += c < 0.5 ? 1 : 0;
+		numNonInteger += c != std::round(c) ? 1 : 0;
+	}
+	checkpoint.close();
+	std::remove(checkpointPath.c_str());
+	EXPECT_GT(numBelowHalf, 0u);
+	EXPECT_GT(numNonInteger, 0u);
+	EXPECT_GT(logSVRRegressor.GetTrainedRegressorParams().C, 0.0);
+	EXPECT_TRUE(std::isfinite(logSVRRegressor.GetTrainingError()));
+}
+
+TEST(FindMinGlobalScaleMapping, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::IterativelyReweightedLeastSquaresRegression<LinkFunctionTypes::LogitLinkFunction<KernelTypes::LinearKernel<SampleType>>> LinearLogitIRLS;
+
+	// log scaled tolerances and penalties alongside fixed integer parameters, each read from its own slot of the map
+	LinearLogitIRLS::FindMinGlobalTrainingParams linearLogitIRLSFMGParams;
+	linearLogitIRLSFMGParams.LowerMaxNumIterations = 11;
+	linearLogitIRLSFMGParams.UpperMaxNumIterations = 11;
+	linearLogitIRLSFMGParams.LowerConvergenceTolerance = 1.e-8;
+	linearLogitIRLSFMGParams.UpperConvergenceTolerance = 1.e-2;
+	linearLogitIRLSFMGParams.ConvergenceToleranceScale = EParameterScale::Log;
+	linearLogitIRLSFMGParams.LowerMaxBasisFunctions = 37;
+	linearLogitIRLSFMGParams.UpperMaxBasisFunctions = 37;
+	linearLogitIRLSFMGParams.LowerLambda = 1.e-6;
+	linearLogitIRLSFMGParams.UpperLambda = 100.0;
+	linearLogitIRLSFMGParams.LambdaScale = EParameterScale::Log;
+
+	std::array<ParameterMapping<T>, LinearLogitIRLS::NumTotalParams> optimiseParamsMap;
+	LinearLogitIRLS::ConfigureMapping(linearLogitIRLSFMGParams, optimiseParamsMap);
+	EXPECT_FALSE(optimiseParamsMap[0].Optimise);
+	EXPECT_TRUE(optimiseParamsMap[1].Optimise);
+	EXPECT_FALSE(optimiseParamsMap[2].Optimise);
+	EXPECT_TRUE(optimiseParamsMap[3].Optimise);
+
+	// both bounds survive the trip to the optimiser's search space and back
+	std::vector<std::pair<T, T>> const bounds = {
+		{ linearLogitIRLSFMGParams.LowerConvergenceTolerance, linearLogitIRLSFMGParams.LowerLambda },
+		{ linearLogitIRLSFMGParams.UpperConvergenceTolerance, linearLogitIRLSFMGParams.UpperLambda } };
+	for (auto const& bound : bounds)
+	{
+		col_vector<T> params(2);
+		params(0) = optimiseParamsMap[1].FromSearchSpace(optimiseParamsMap[1].ToSearchSpace(bound.first));
+		params(1) = optimiseParamsMap[3].FromSearchSpace(optimiseParamsMap[3].ToSearchSpace(bound.second));
+		size_t paramsOffset = 0u;
+		LinearLogitIRLS::OneShotTrainingParams const osParams(params, optimiseParamsMap, paramsOffset);
+		EXPECT_EQ(paramsOffset, 2u);
+		EXPECT_EQ(osParams.MaxNumIterations, 11u);
+		EXPECT_NEAR(osParams.ConvergenceTolerance, bound.first, bound.first * 1.e-12);
+		EXPECT_EQ(osParams.MaxBasisFunctions, 37u);
+		EXPECT_NEAR(osParams.Lambda, bound.second, bound.second * 1.e-12);
+	}
+
+	// held parameters keep their fixed values rather than their neighbours'
+	LinearLogitIRLS::FindMinGlobalTrainingParams fixedIRLSFMGParams(linearLogitIRLSFMGParams);
+	fixedIRLSFMGParams.UpperConvergenceTolerance = fixedIRLSFMGParams.LowerConvergenceTolerance;
+	fixedIRLSFMGParams.UpperLambda = fixedIRLSFMGParams.LowerLambda;
+	fixedIRLSFMGParams.UpperMaxNumIterations = 12;
+	std::array<ParameterMapping<T>, LinearLogitIRLS::NumTotalParams> fixedParamsMap;
+	LinearLogitIRLS::ConfigureMapping(fixedIRLSFMGParams, fixedParamsMap);
+	col_vector<T> params(1);
+	params(0) = 12;
+	size_t paramsOffset = 0u;
+	LinearLogitIRLS::OneShotTrainingParams const fixedParams(params, fixedParamsMap, paramsOffset);
+	EXPECT_EQ(paramsOffset, 1u);
+	EXPECT_EQ(fixedParams.MaxNumIterations, 12u);
+	EXPECT_EQ(fixedParams.ConvergenceTolerance, fixedIRLSFMGParams.LowerConvergenceTolerance);
+	EXPECT_EQ(fixedParams.MaxBasisFunctions, 37u);
+	EXPECT_EQ(fixedParams.Lambda, fixedIRLSFMGParams.LowerLambda);
+}
+
+TEST(FindMinGlobalMultiFidelityEfficiency, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	T const optimisationTolerance = 1.e-2;
+	size_t const maxNumCalls = 40;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::FindMinGlobalTrainingParams normaliserFMGParams;
+
+	RadialBasisKRR::FindMinGlobalTrainingParams radialBasisKRRFMGParams;
+	radialBasisKRRFMGParams.LowerLambda = 1.e-6;
+	radialBasisKRRFMGParams.UpperLambda = 10.0;
+	radialBasisKRRFMGParams.LowerMaxBasisFunctions = 50;
+	radialBasisKRRFMGParams.UpperMaxBasisFunctions = 100;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.LowerGamma = 1.0;
+	radialBasisKRRFMGParams.KernelFindMinGlobalTrainingParams.UpperGamma = 2.0;
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	options.NumConcurrentEvaluations = 4;
+
+	std::string const plainCheckpointPath = "FindMinGlobalPlainEfficiencyCheckpoint.dat";
+	std::remove(plainCheckpointPath.c_str());
+	TrainingOptions<T> plainOptions(options);
+	plainOptions.CheckpointPath = plainCheckpointPath;
+	std::vector<T> plainDiagnostics;
+	auto const plainRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, maxNumCalls, plainOptions, plainDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	std::vector<double> const plainScores = ReadCheckpointScores(plainCheckpointPath);
+	std::remove(plainCheckpointPath.c_str());
+
+	// pruned points cost calls but no full-data evaluation, so the multi-fidelity search is given more calls and compared
+	// on the full-data evaluations it needs to reach the plain search's best score
+	std::string const multiFidelityCheckpointPath = "FindMinGlobalMultiFidelityEfficiencyCheckpoint.dat";
+	std::remove(multiFidelityCheckpointPath.c_str());
+	TrainingOptions<T> multiFidelityOptions(options);
+	multiFidelityOptions.CheckpointPath = multiFidelityCheckpointPath;
+	multiFidelityOptions.MultiFidelityMinNumExamples = 12;
+	multiFidelityOptions.MultiFidelityReductionFactor = 2;
+	std::vector<T> multiFidelityDiagnostics;
+	auto const multiFidelityRegressor = RegressorTrainer::TrainRegressorFindMinGlobal<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, optimisationTolerance, 2 * maxNumCalls, multiFidelityOptions, multiFidelityDiagnostics, radialBasisKRRFMGParams, normaliserFMGParams);
+	std::vector<double> const multiFidelityScores = ReadCheckpointScores(multiFidelityCheckpointPath);
+	std::remove(multiFidelityCheckpointPath.c_str());
+
+	T const targetError = plainRegressor.GetTrainingError();
+	auto const reachesTarget = [targetError](double const score)
+	{
+		return score <= targetError;
+	};
+	auto const plainReached = std::find_if(plainScores.begin(), plainScores.end(), reachesTarget);
+	auto const multiFidelityReached = std::find_if(multiFidelityScores.begin(), multiFidelityScores.end(), reachesTarget);
+	ASSERT_NE(plainReached, plainScores.end());
+	ASSERT_NE(multiFidelityReached, multiFidelityScores.end());
+	EXPECT_LE(multiFidelityReached - multiFidelityScores.begin(), plainReached - plainScores.begin());
+	EXPECT_LE(multiFidelityRegressor.GetTrainingError(), targetError);
+}
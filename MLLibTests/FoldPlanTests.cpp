@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include <MLLib/Regressor.h>
+#include <dlib/md5.h>
+
+template <typename T>
+std::string GetMD5(T const& item)
+{
+	using namespace dlib;
+	std::stringstream ss;
+	serialize(item, ss);
+	return dlib::md5(ss);
+}
+
+TEST(FoldPlanPartitioning, RegressorTests)
+{
+	using namespace Regressors;
+
+	static size_t const numExamples = 50;
+	size_t const numFolds = 4;
+	size_t const chunks = numExamples / numFolds;
+	std::string const randomSeed = "MLLib";
+
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	EXPECT_EQ(foldPlan.GetNumExamples(), numExamples);
+	EXPECT_EQ(foldPlan.GetNumFolds(), numFolds);
+
+	std::vector<size_t> testCount(numExamples, 0);
+	for (size_t fold = 0; fold < numFolds; ++fold)
+	{
+		auto const& trainIndices = foldPlan.GetTrainIndices(fold);
+		auto const& testIndices = foldPlan.GetTestIndices(fold);
+		EXPECT_EQ(testIndices.size(), chunks);
+		EXPECT_EQ(trainIndices.size() + testIndices.size(), numExamples);
+
+		std::vector<bool> seen(numExamples, false);
+		for (auto const index : trainIndices)
+		{
+			EXPECT_FALSE(seen[index]);
+			seen[index] = true;
+		}
+		for (auto const index : testIndices)
+		{
+			EXPECT_FALSE(seen[index]);
+			seen[index] = true;
+			++testCount[index];
+		}
+	}
+
+	// every example is tested at most once; the remainder of numExamples / numFolds is never tested
+	EXPECT_EQ(static_cast<size_t>(std::count(testCount.begin(), testCount.end(), 1u)), numFolds * chunks);
+	EXPECT_EQ(static_cast<size_t>(std::count(testCount.begin(), testCount.end(), 0u)), numExamples - numFolds * chunks);
+
+	FoldPlan const repeatedFoldPlan(randomSeed, numExamples, numFolds);
+	EXPECT_EQ(repeatedFoldPlan.GetShuffledIndices(), foldPlan.GetShuffledIndices());
+}
+
+TEST(FoldPlanTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 4;
+
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+
+	RadialBasisKRR::OneShotTrainingParams radialBasisKRROSParams;
+	radialBasisKRROSParams.MaxBasisFunctions = 400;
+	radialBasisKRROSParams.Lambda = 1e-6;
+	radialBasisKRROSParams.KernelOneShotTrainingParams.Gamma = 1.0;
+
+	std::vector<T> seedDiagnostics;
+	auto const seedRegressor = RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, seedDiagnostics, radialBasisKRROSParams, normaliserOSParams);
+
+	// the shared plan is cross-validated with its folds trained concurrently, which must not change the result
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	std::vector<T> foldPlanDiagnostics;
+	auto const foldPlanRegressor = RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, options, foldPlanDiagnostics, radialBasisKRROSParams, normaliserOSParams);
+
+	EXPECT_EQ(GetMD5(foldPlanRegressor), GetMD5(seedRegressor));
+	EXPECT_EQ(GetMD5(foldPlanDiagnostics), GetMD5(seedDiagnostics));
+}
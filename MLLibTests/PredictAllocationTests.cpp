@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include <MLLib/Regressor.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// every heap allocation made by the test binary is counted, so a test can assert that a region of code made none
+static std::atomic<size_t> NumAllocations(0);
+
+void* operator new(std::size_t size)
+{
+	++NumAllocations;
+	if (void* const ptr = std::malloc(size == 0 ? 1 : size))
+	{
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+TEST(PredictAllocation, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+	ModifierTypes::FeatureSelectionModifier<SampleType>::OneShotTrainingParams featureSelectionOSParams;
+	featureSelectionOSParams.FeatureFraction = 0.7;
+	ModifierTypes::InputPCAModifier<SampleType>::OneShotTrainingParams PCAOSParams;
+	PCAOSParams.TargetVariance = 0.9;
+
+	RadialBasisKRR::OneShotTrainingParams radialBasisKRROSParams;
+	radialBasisKRROSParams.MaxBasisFunctions = 400;
+	radialBasisKRROSParams.Lambda = 1e-6;
+	radialBasisKRROSParams.KernelOneShotTrainingParams.Gamma = 1.0;
+
+	std::vector<T> diagnostics;
+	Regressor<SampleType> const regressor = RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, diagnostics, radialBasisKRROSParams, normaliserOSParams, featureSelectionOSParams, PCAOSParams);
+
+	std::vector<T> expected(numExamples);
+	std::vector<T> predictions(numExamples);
+	PredictionWorkspace<SampleType> workspace;
+
+	// the first predictions size the thread's workspace, including its batch buffers, and the caller's workspace
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		expected[e] = regressor.Predict(inputExamples[e]);
+	}
+	regressor.Predict(inputExamples.front(), workspace);
+	regressor.PredictBatch(inputExamples.data(), predictions.data(), numExamples);
+
+	size_t const numAllocationsBefore = NumAllocations;
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		predictions[e] = regressor.Predict(inputExamples[e]);
+	}
+	EXPECT_EQ(NumAllocations, numAllocationsBefore);
+	EXPECT_EQ(predictions, expected);
+
+	size_t const numWorkspaceAllocationsBefore = NumAllocations;
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		predictions[e] = regressor.Predict(inputExamples[e], workspace);
+	}
+	EXPECT_EQ(NumAllocations, numWorkspaceAllocationsBefore);
+	EXPECT_EQ(predictions, expected);
+
+	size_t const numBatchAllocationsBefore = NumAllocations;
+	regressor.PredictBatch(inputExamples.data(), predictions.data(), numExamples);
+	EXPECT_EQ(NumAllocations, numBatchAllocationsBefore);
+	EXPECT_EQ(predictions, expected);
+
+	// a chain without a dense transform is not fused, so its inputs pass through each modifier in turn, starting with a
+	// feature selection that changes their number of ordinates
+	std::vector<T> unfusedDiagnostics;
+	Regressor<SampleType> const unfusedRegressor = RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, unfusedDiagnostics, radialBasisKRROSParams, featureSelectionOSParams, normaliserOSParams);
+
+	std::vector<T> unfusedExpected(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		unfusedExpected[e] = unfusedRegressor.Predict(inputExamples[e]);
+	}
+	unfusedRegressor.PredictBatch(inputExamples.data(), predictions.data(), numExamples);
+
+	size_t const numUnfusedAllocationsBefore = NumAllocations;
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		predictions[e] = unfusedRegressor.Predict(inputExamples[e]);
+	}
+	EXPECT_EQ(NumAllocations, numUnfusedAllocationsBefore);
+	EXPECT_EQ(predictions, unfusedExpected);
+
+	size_t const numUnfusedBatchAllocationsBefore = NumAllocations;
+	unfusedRegressor.PredictBatch(inputExamples.data(), predictions.data(), numExamples);
+	EXPECT_EQ(NumAllocations, numUnfusedBatchAllocationsBefore);
+	EXPECT_EQ(predictions, unfusedExpected);
+}
@@ -0,0 +1,256 @@
+#include "gtest/gtest.h"
+#include <MLLib/Regressor.h>
+#include <dlib/md5.h>
+
+template <typename T>
+std::string GetMD5(T const& item)
+{
+	using namespace dlib;
+	std::stringstream ss;
+	serialize(item, ss);
+	return dlib::md5(ss);
+}
+
+template <class RegressionType, class SampleType>
+void CheckKernelExpansion(std::vector<SampleType> const& inputExamples, std::vector<typename SampleType::type> const& targetExamples, typename RegressionType::OneShotTrainingParams const& regressorOSParams)
+{
+	using namespace Regressors;
+	typedef typename SampleType::type T;
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+
+	std::vector<T> diagnostics;
+	auto const trained = RegressorTrainer::TrainRegressorOneShot<RegressionType>(inputExamples, targetExamples, randomSeed, metric, numFolds, diagnostics, regressorOSParams, normaliserOSParams);
+	Regressor<SampleType> const regressor(trained);
+
+	// enough samples for several batch chunks and a final partial one
+	std::vector<SampleType> batchInputs;
+	for (size_t repeat = 0; repeat < 3; ++repeat)
+	{
+		batchInputs.insert(batchInputs.end(), inputExamples.begin(), inputExamples.end());
+	}
+	std::vector<T> const batchPredictions = regressor.PredictBatch(batchInputs);
+
+	// the expansion agrees with the dlib decision function up to rounding, and batches agree with single predictions
+	PredictionWorkspace<SampleType> workspace;
+	for (size_t i = 0; i < batchInputs.size(); ++i)
+	{
+		T const prediction = regressor.Predict(batchInputs[i]);
+		T const referencePrediction = trained.PredictThroughModifiers(batchInputs[i], workspace);
+		EXPECT_NEAR(prediction, referencePrediction, 1.e-6 * std::max(T(1), std::abs(referencePrediction)));
+		EXPECT_EQ(batchPredictions[i], prediction);
+	}
+}
+
+TEST(PredictKernelExpansion, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::LinearKernel<SampleType>> LinearKRR;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::PolynomialKernel<SampleType>> PolynomialKRR;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+	typedef RegressionTypes::SupportVectorRegression<KernelTypes::SigmoidKernel<SampleType>> SigmoidSVR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	LinearKRR::OneShotTrainingParams linearKRROSParams;
+	linearKRROSParams.MaxBasisFunctions = 400;
+	linearKRROSParams.Lambda = 1e-6;
+	CheckKernelExpansion<LinearKRR>(inputExamples, targetExamples, linearKRROSParams);
+
+	PolynomialKRR::OneShotTrainingParams polynomialKRROSParams;
+	polynomialKRROSParams.MaxBasisFunctions = 400;
+	polynomialKRROSParams.Lambda = 1e-6;
+	polynomialKRROSParams.KernelOneShotTrainingParams.Gamma = 0.1;
+	polynomialKRROSParams.KernelOneShotTrainingParams.Coeff = 1.0;
+	polynomialKRROSParams.KernelOneShotTrainingParams.Degree = 2.0;
+	CheckKernelExpansion<PolynomialKRR>(inputExamples, targetExamples, polynomialKRROSParams);
+
+	RadialBasisKRR::OneShotTrainingParams radialBasisKRROSParams;
+	radialBasisKRROSParams.MaxBasisFunctions = 400;
+	radialBasisKRROSParams.Lambda = 1e-6;
+	radialBasisKRROSParams.KernelOneShotTrainingParams.Gamma = 1.0;
+	CheckKernelExpansion<RadialBasisKRR>(inputExamples, targetExamples, radialBasisKRROSParams);
+
+	SigmoidSVR::OneShotTrainingParams sigmoidSVROSParams;
+	sigmoidSVROSParams.C = 10.0;
+	sigmoidSVROSParams.Epsilon = 1e-3;
+	sigmoidSVROSParams.EpsilonInsensitivity = 0.1;
+	sigmoidSVROSParams.KernelOneShotTrainingParams.Gamma = 0.1;
+	sigmoidSVROSParams.KernelOneShotTrainingParams.Coeff = -1.0;
+	CheckKernelExpansion<SigmoidSVR>(inputExamples, targetExamples, sigmoidSVROSParams);
+}
+
+TEST(PredictBatch, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+	typedef RegressionTypes::RandomForestRegression<KernelTypes::DenseExtractor<SampleType>> DenseRF;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 4;
+
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+	ModifierTypes::InputPCAModifier<SampleType>::OneShotTrainingParams PCAOSParams;
+	PCAOSParams.TargetVariance = 0.9;
+
+	RadialBasisKRR::OneShotTrainingParams radialBasisKRROSParams;
+	radialBasisKRROSParams.MaxBasisFunctions = 400;
+	radialBasisKRROSParams.Lambda = 1e-6;
+	radialBasisKRROSParams.KernelOneShotTrainingParams.Gamma = 1.0;
+
+	DenseRF::OneShotTrainingParams denseRFOSParams;
+	denseRFOSParams.NumTrees = 100;
+	denseRFOSParams.MinSamplesPerLeaf = 5;
+	denseRFOSParams.SubsamplingFraction = 0.5;
+
+	std::vector<T> diagnostics;
+	std::vector<Regressor<SampleType>> regressors;
+	regressors.emplace_back(RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, diagnostics, radialBasisKRROSParams, normaliserOSParams, PCAOSParams));
+	regressors.emplace_back(RegressorTrainer::TrainRegressorOneShot<DenseRF>(inputExamples, targetExamples, randomSeed, metric, numFolds, diagnostics, denseRFOSParams, normaliserOSParams));
+
+	// a batch large enough to be split across the pool, of perturbed copies of the training examples
+	size_t const numBatchSamples = 3000;
+	std::vector<SampleType> batch(numBatchSamples);
+	for (size_t i = 0; i < numBatchSamples; ++i)
+	{
+		batch[i] = inputExamples[i % numExamples] * (1.0 + 1.e-3 * static_cast<T>(i / numExamples));
+	}
+
+	dlib::thread_pool tp(numThreads);
+	for (auto const& regressor : regressors)
+	{
+		std::vector<T> expected(numBatchSamples);
+		for (size_t i = 0; i < numBatchSamples; ++i)
+		{
+			expected[i] = regressor.Predict(batch[i]);
+		}
+
+		// the batch must apply the same modifier chain and decision function as per-sample prediction, in or out of a pool
+		EXPECT_EQ(GetMD5(regressor.PredictBatch(batch)), GetMD5(expected));
+		EXPECT_EQ(GetMD5(regressor.PredictBatch(batch, &tp)), GetMD5(expected));
+
+		// a sub-range of caller-owned storage is written in place and nothing around it is touched
+		std::vector<T> outputs(numBatchSamples + 2, -1.0);
+		regressor.PredictBatch(batch.data() + 1, outputs.data() + 1, numBatchSamples - 1, &tp);
+		EXPECT_EQ(outputs[0], -1.0);
+		EXPECT_EQ(outputs[1], expected[1]);
+		EXPECT_EQ(outputs[numBatchSamples - 1], expected.back());
+		EXPECT_EQ(outputs[numBatchSamples], -1.0);
+		EXPECT_EQ(outputs[numBatchSamples + 1], -1.0);
+
+		EXPECT_TRUE(regressor.PredictBatch(std::vector<SampleType>(), &tp).empty());
+	}
+}
+
+TEST(PredictFusedModifiers, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+
+	ModifierTypes::NormaliserModifier<SampleType>::OneShotTrainingParams normaliserOSParams;
+	ModifierTypes::InputPCAModifier<SampleType>::OneShotTrainingParams PCAOSParams;
+	PCAOSParams.TargetVariance = 0.9;
+
+	RadialBasisKRR::OneShotTrainingParams radialBasisKRROSParams;
+	radialBasisKRROSParams.MaxBasisFunctions = 400;
+	radialBasisKRROSParams.Lambda = 1e-6;
+	radialBasisKRROSParams.KernelOneShotTrainingParams.Gamma = 1.0;
+
+	std::vector<T> diagnostics;
+	auto const trained = RegressorTrainer::TrainRegressorOneShot<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, diagnostics, radialBasisKRROSParams, normaliserOSParams, PCAOSParams);
+	Regressor<SampleType> const regressor(trained);
+
+	std::stringstream ss;
+	serialize(regressor, ss);
+	Regressor<SampleType> deserialisedRegressor;
+	deserialize(deserialisedRegressor, ss);
+
+	// the fused normaliser and PCA map, followed by the kernel expansion, agrees with applying the modifiers in turn and
+	// the dlib decision function up to rounding, and is rebuilt on deserialisation
+	PredictionWorkspace<SampleType> workspace;
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		T const fusedPrediction = regressor.Predict(inputExamples[e]);
+		T const unfusedPrediction = trained.PredictThroughModifiers(inputExamples[e], workspace);
+		EXPECT_NEAR(fusedPrediction, unfusedPrediction, 1.e-9 * std::max(T(1), std::abs(unfusedPrediction)));
+		EXPECT_EQ(deserialisedRegressor.Predict(inputExamples[e]), fusedPrediction);
+	}
+
+	// normalisation and feature selection neither mix ordinates, so they are applied in turn rather than as a dense map,
+	// and a regressor without a kernel expansion predicts exactly as the modifiers applied one by one do
+	typedef RegressionTypes::RandomForestRegression<KernelTypes::DenseExtractor<SampleType>> DenseRF;
+	ModifierTypes::FeatureSelectionModifier<SampleType>::OneShotTrainingParams featureSelectionOSParams;
+	featureSelectionOSParams.FeatureFraction = 0.7;
+	DenseRF::OneShotTrainingParams denseRFOSParams;
+	denseRFOSParams.NumTrees = 100;
+	denseRFOSParams.MinSamplesPerLeaf = 5;
+	denseRFOSParams.SubsamplingFraction = 0.5;
+	std::vector<T> selectedDiagnostics;
+	auto const selectedTrained = RegressorTrainer::TrainRegressorOneShot<DenseRF>(inputExamples, targetExamples, randomSeed, metric, numFolds, selectedDiagnostics, denseRFOSParams, normaliserOSParams, featureSelectionOSParams);
+	std::vector<T> const selectedBatchPredictions = Regressor<SampleType>(selectedTrained).PredictBatch(inputExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		T const prediction = selectedTrained.Predict(inputExamples[e], workspace);
+		EXPECT_EQ(prediction, selectedTrained.PredictThroughModifiers(inputExamples[e], workspace));
+		EXPECT_EQ(selectedBatchPredictions[e], prediction);
+	}
+}
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include <MLLib/Regressor.h>
+#include <dlib/md5.h>
+#include <algorithm>
+
+template <typename T>
+std::string GetMD5(T const& item)
+{
+	using namespace dlib;
+	std::stringstream ss;
+	serialize(item, ss);
+	return dlib::md5(ss);
+}
+
+TEST(RandomSearchTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.MaxBasisFunctionsToTry = { 400 };
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3, 1.0, 1.e3 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-3, 1.e-1, 1.0, 1.e1 };
+	size_t const gridSize = radialBasisKRRCVParams.LambdaToTry.size() * radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry.size();
+
+	std::vector<T> gridDiagnostics;
+	auto const gridRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, gridDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+
+	// a budget that covers the grid cross-validates all of it, exactly as in the grid search
+	std::vector<T> fullBudgetDiagnostics;
+	auto const fullBudgetRegressor = RegressorTrainer::TrainRegressorRandomSearch<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, gridSize, fullBudgetDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(fullBudgetRegressor), GetMD5(gridRegressor));
+	EXPECT_EQ(GetMD5(fullBudgetDiagnostics), GetMD5(gridDiagnostics));
+
+	// a smaller budget scores a subset of the grid on the same folds, so the grid's best can only be matched, and the
+	// sample is drawn from the fold plan's random stream so it must not depend on the number of threads
+	size_t const numSamples = 5;
+	std::vector<T> serialDiagnostics;
+	auto const serialRegressor = RegressorTrainer::TrainRegressorRandomSearch<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, 1, numSamples, serialDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	std::vector<T> parallelDiagnostics;
+	auto const parallelRegressor = RegressorTrainer::TrainRegressorRandomSearch<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, numSamples, parallelDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(parallelRegressor), GetMD5(serialRegressor));
+	EXPECT_EQ(GetMD5(parallelDiagnostics), GetMD5(serialDiagnostics));
+	EXPECT_GE(serialRegressor.GetTrainingError(), gridRegressor.GetTrainingError());
+
+	// every parameter is stratified on its own, so a budget at least as large as each parameter's number of values tries
+	// all of them, and samples that meet on one grid point are replaced so that the whole budget is spent on distinct points
+	FoldPlan const foldPlan(randomSeed, numExamples, numFolds);
+	auto const candidates = RegressorTrainer::GetRandomSearchCandidates<RadialBasisKRR>(foldPlan, numSamples, radialBasisKRRCVParams, normaliserCVParams);
+	ASSERT_EQ(candidates.size(), numSamples);
+	for (auto const lambda : radialBasisKRRCVParams.LambdaToTry)
+	{
+		EXPECT_TRUE(std::any_of(candidates.begin(), candidates.end(), [&](auto const& candidate) { return candidate.first.Lambda == lambda; })) << "Lambda " << lambda;
+	}
+	for (auto const gamma : radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry)
+	{
+		EXPECT_TRUE(std::any_of(candidates.begin(), candidates.end(), [&](auto const& candidate) { return candidate.first.KernelOneShotTrainingParams.Gamma == gamma; })) << "Gamma " << gamma;
+	}
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		for (size_t j = i + 1; j < candidates.size(); ++j)
+		{
+			EXPECT_FALSE(candidates[i].first.Lambda == candidates[j].first.Lambda
+				&& candidates[i].first.KernelOneShotTrainingParams.Gamma == candidates[j].first.KernelOneShotTrainingParams.Gamma);
+		}
+	}
+
+	// the search scores exactly those candidates
+	TrainingOptions<T> options;
+	options.NumThreads = numThreads;
+	std::vector<CrossValidationReport<T>> candidateReports;
+	options.CandidateReports = &candidateReports;
+	std::vector<T> reportedDiagnostics;
+	auto const reportedRegressor = RegressorTrainer::TrainRegressorRandomSearch<RadialBasisKRR>(inputExamples, targetExamples, foldPlan, metric, numSamples, options, reportedDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(reportedRegressor), GetMD5(serialRegressor));
+	EXPECT_EQ(candidateReports.size(), numSamples);
+}
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include <MLLib/Regressor.h>
+#include <thread>
+
+TEST(RandomStreamDraws, RegressorTests)
+{
+	using namespace Regressors;
+
+	static size_t const numDraws = 1000;
+	std::string const randomSeed = "MLLib";
+
+	RandomStream stream(randomSeed);
+	RandomStream repeatedStream(randomSeed);
+	RandomStream otherSeedStream("MLLib2");
+	size_t numDifferent = 0;
+	for (size_t i = 0; i < numDraws; ++i)
+	{
+		dlib::uint32 const value = stream.GetRandom32BitNumber();
+		EXPECT_EQ(repeatedStream.GetRandom32BitNumber(), value);
+		numDifferent += otherSeedStream.GetRandom32BitNumber() != value ? 1 : 0;
+	}
+	EXPECT_GT(numDifferent, numDraws - 2);
+
+	dlib::running_stats<double> rs;
+	for (size_t i = 0; i < numDraws; ++i)
+	{
+		double const value = stream.GetRandomDouble();
+		EXPECT_GE(value, 0.0);
+		EXPECT_LT(value, 1.0);
+		rs.add(value);
+
+		EXPECT_LT(stream.GetRandomIndex(7), 7u);
+	}
+	EXPECT_NEAR(rs.mean(), 0.5, 0.05);
+}
+
+TEST(RandomStreamSubstreams, RegressorTests)
+{
+	using namespace Regressors;
+
+	static size_t const numSubstreams = 16;
+	static size_t const numDraws = 100;
+	std::string const randomSeed = "MLLib";
+
+	// substreams drawn on their own threads must reproduce the numbers drawn from them in order on one thread
+	RandomStream const root(randomSeed);
+	std::vector<std::vector<dlib::uint64>> serialDraws(numSubstreams, std::vector<dlib::uint64>(numDraws));
+	for (size_t s = 0; s < numSubstreams; ++s)
+	{
+		RandomStream substream = root.GetSubstream(s);
+		for (auto& draw : serialDraws[s])
+		{
+			draw = substream.GetRandom64BitNumber();
+		}
+	}
+
+	std::vector<std::vector<dlib::uint64>> threadedDraws(numSubstreams, std::vector<dlib::uint64>(numDraws));
+	std::vector<std::thread> threads;
+	for (size_t s = 0; s < numSubstreams; ++s)
+	{
+		threads.emplace_back([&, s]()
+			{
+				RandomStream substream = root.GetSubstream(s);
+				for (auto& draw : threadedDraws[s])
+				{
+					draw = substream.GetRandom64BitNumber();
+				}
+			});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	EXPECT_EQ(threadedDraws, serialDraws);
+
+	// distinct ids give distinct streams, and deriving a substream leaves its parent untouched
+	EXPECT_NE(serialDraws[0], serialDraws[1]);
+	EXPECT_NE(root.GetSubstream(0).GetSubstream(1).GetRandom64BitNumber(), root.GetSubstream(1).GetSubstream(0).GetRandom64BitNumber());
+	RandomStream parent(randomSeed);
+	RandomStream untouchedParent(randomSeed);
+	parent.GetSubstream(3);
+	EXPECT_EQ(parent.GetRandom64BitNumber(), untouchedParent.GetRandom64BitNumber());
+}
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include <MLLib/Regressor.h>
+#include <dlib/md5.h>
+
+template <typename T>
+std::string GetMD5(T const& item)
+{
+	using namespace dlib;
+	std::stringstream ss;
+	serialize(item, ss);
+	return dlib::md5(ss);
+}
+
+TEST(SuccessiveHalvingTraining, RegressorTests)
+{
+	using namespace Regressors;
+	typedef col_vector<double> SampleType;
+	typedef typename SampleType::type T;
+	typedef RegressionTypes::KernelRidgeRegression<KernelTypes::RadialBasisKernel<SampleType>> RadialBasisKRR;
+
+	static size_t const numExamples = 50;
+	static size_t const numOrdinates = 10;
+
+	std::vector<SampleType> inputExamples(numExamples, SampleType(numOrdinates));
+	std::vector<T> targetExamples(numExamples);
+	for (size_t e = 0; e < numExamples; ++e)
+	{
+		for (size_t o = 0; o < numOrdinates; ++o)
+		{
+			T sinArg = static_cast<T>(e + 1);
+			inputExamples[e](o) = std::sin(sinArg * sinArg) * std::exp(static_cast<T>(o));
+		}
+		targetExamples[e] = static_cast<T>(e + 1) + std::sin(static_cast<T>(e) * 0.1 * dlib::pi * 2.0);
+	}
+
+	std::string const randomSeed = "MLLib";
+	ECrossValidationMetric const metric = ECrossValidationMetric::SumSquareMean;
+	size_t const numFolds = 4;
+	size_t const numThreads = 16;
+	size_t const reductionFactor = 2;
+
+	ModifierTypes::NormaliserModifier<SampleType>::CrossValidationTrainingParams normaliserCVParams;
+
+	RadialBasisKRR::CrossValidationTrainingParams radialBasisKRRCVParams;
+	radialBasisKRRCVParams.MaxBasisFunctionsToTry = { 400 };
+	radialBasisKRRCVParams.LambdaToTry = { 1.e-6, 1.e-3, 1.0, 1.e3 };
+	radialBasisKRRCVParams.KernelCrossValidationTrainingParams.GammaToTry = { 1.e-3, 1.e-1, 1.0, 1.e1 };
+
+	std::vector<T> gridDiagnostics;
+	auto const gridRegressor = RegressorTrainer::TrainRegressorCrossValidation<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, gridDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+
+	// with no room for a smaller rung every candidate is cross-validated on the full data, exactly as in the grid search
+	std::vector<T> singleRungDiagnostics;
+	auto const singleRungRegressor = RegressorTrainer::TrainRegressorSuccessiveHalving<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, reductionFactor, numExamples, singleRungDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(singleRungRegressor), GetMD5(gridRegressor));
+	EXPECT_EQ(GetMD5(singleRungDiagnostics), GetMD5(gridDiagnostics));
+
+	// rungs of 12, 25 and 50 examples; the survivors are a subset of the grid scored on the same folds, so the grid's
+	// best can only be matched, and the result must not depend on the number of threads
+	size_t const minNumExamples = 12;
+	std::vector<T> serialDiagnostics;
+	auto const serialRegressor = RegressorTrainer::TrainRegressorSuccessiveHalving<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, 1, reductionFactor, minNumExamples, serialDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	std::vector<T> parallelDiagnostics;
+	auto const parallelRegressor = RegressorTrainer::TrainRegressorSuccessiveHalving<RadialBasisKRR>(inputExamples, targetExamples, randomSeed, metric, numFolds, numThreads, reductionFactor, minNumExamples, parallelDiagnostics, radialBasisKRRCVParams, normaliserCVParams);
+	EXPECT_EQ(GetMD5(parallelRegressor), GetMD5(serialRegressor));
+	EXPECT_EQ(GetMD5(parallelDiagnostics), GetMD5(serialDiagnostics));
+	EXPECT_GE(serialRegressor.GetTrainingError(), gridRegressor.GetTrainingError());
+}
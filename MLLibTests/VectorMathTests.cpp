@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include <MLLib/VectorMath.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// distance between two doubles in units in the last place, counting across zero
+static double GetULPDistance(double const a, double const b)
+{
+	auto const toOrdered = [](double const value)
+		{
+			int64_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits < 0 ? std::numeric_limits<int64_t>::min() - bits : bits;
+		};
+	return std::abs(static_cast<double>(toOrdered(a) - toOrdered(b)));
+}
+
+TEST(VectorMathAccuracy, RegressorTests)
+{
+	using namespace Regressors::VectorMath;
+
+	// arguments across the whole range of each function, with fine spacing where the approximations switch
+	std::vector<double> expArguments;
+	for (double x = -745.0; x <= 709.7; x += 0.0731)
+	{
+		expArguments.push_back(x);
+	}
+	std::vector<double> tanhArguments;
+	for (double x = -25.0; x <= 25.0; x += 0.00173)
+	{
+		tanhArguments.push_back(x);
+	}
+	for (double x = 1.e-12; x < 1.0; x *= 1.37)
+	{
+		tanhArguments.push_back(x);
+		tanhArguments.push_back(-x);
+	}
+
+	std::vector<EInstructionSet> instructionSets = { EInstructionSet::Scalar };
+	if (GetInstructionSet() >= EInstructionSet::AVX2)
+	{
+		instructionSets.push_back(EInstructionSet::AVX2);
+	}
+	if (GetInstructionSet() >= EInstructionSet::AVX512)
+	{
+		instructionSets.push_back(EInstructionSet::AVX512);
+	}
+
+	for (auto const instructionSet : instructionSets)
+	{
+		std::vector<double> exps = expArguments;
+		Exp(exps.data(), exps.size(), instructionSet);
+		for (size_t i = 0; i < expArguments.size(); ++i)
+		{
+			double const expected = std::exp(expArguments[i]);
+			if (expected >= std::numeric_limits<double>::min())
+			{
+				EXPECT_LE(GetULPDistance(exps[i], expected), 2.0) << "exp(" << expArguments[i] << ")";
+			}
+			else
+			{
+				EXPECT_NEAR(exps[i], expected, std::numeric_limits<double>::min());
+			}
+		}
+
+		std::vector<double> tanhs = tanhArguments;
+		Tanh(tanhs.data(), tanhs.size(), instructionSet);
+		for (size_t i = 0; i < tanhArguments.size(); ++i)
+		{
+			EXPECT_LE(GetULPDistance(tanhs[i], std::tanh(tanhArguments[i])), 4.0) << "tanh(" << tanhArguments[i] << ")";
+		}
+
+		// results do not depend on where a value sits in the array, so blocks of any length agree with the whole
+		std::vector<double> wholeExps(expArguments.begin(), expArguments.begin() + 37);
+		Exp(wholeExps.data(), wholeExps.size(), instructionSet);
+		for (size_t i = 0; i < wholeExps.size(); ++i)
+		{
+			double singleExp = expArguments[i];
+			Exp(&singleExp, 1, instructionSet);
+			EXPECT_EQ(singleExp, wholeExps[i]);
+		}
+
+		double special[] = { 0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() };
+		Exp(special, 4, instructionSet);
+		EXPECT_EQ(special[0], 1.0);
+		EXPECT_EQ(special[1], std::numeric_limits<double>::infinity());
+		EXPECT_EQ(special[2], 0.0);
+		EXPECT_TRUE(std::isnan(special[3]));
+	}
+}